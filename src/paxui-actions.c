@@ -8,17 +8,7 @@
 static PaxuiLeaf *
 find_sink_for_name (const Paxui *paxui, const gchar *name)
 {
-    GList *l;
-    PaxuiLeaf *sk;
-
-    for (l = paxui->sinks; l; l = l->next)
-    {
-        sk = l->data;
-
-        if (g_strcmp0 (sk->name, name) == 0) return sk;
-    }
-
-    return NULL;
+    return paxui_find_leaf_for_name (paxui, PAXUI_LEAF_TYPE_SINK, name);
 }
 
 
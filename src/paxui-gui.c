@@ -12,6 +12,10 @@
 
 #define PAXUI_SPACE (24)
 #define PAXUI_LINE_WIDTH (10)
+#define PAXUI_EDGE_ROW (64)         /* band height of edge index */
+#define PAXUI_POOL_MAX (16)         /* spare widgets kept per leaf type */
+#define PAXUI_POPOVER_IDLE (60)     /* secs closed before tool popover is freed */
+#define PAXUI_ERROR_SECS (5)        /* secs a failure is shown in title bar */
 
 
 enum
@@ -63,6 +67,123 @@ paxui_gui_get_default_colours (Paxui *paxui)
 }
 
 
+/* occupied rows are tracked per column as bitsets, kept in step with
+ * attach & detach, so free rows can be found without asking the grid */
+static GArray *
+grid_column (Paxui *paxui, gint x)
+{
+    if (x < 0 || x >= PAXUI_GRID_COLS) return NULL;
+
+    if (paxui->grid_used[x] == NULL)
+        paxui->grid_used[x] = g_array_new (FALSE, TRUE, sizeof (guint32));
+
+    return paxui->grid_used[x];
+}
+
+static void
+grid_cell_set (Paxui *paxui, gint x, gint y, gboolean used)
+{
+    GArray *col;
+    guint word;
+
+    if (y < 0 || (col = grid_column (paxui, x)) == NULL) return;
+
+    word = y / 32;
+    if (word >= col->len)
+    {
+        if (!used) return;
+        g_array_set_size (col, word + 1);
+    }
+
+    if (used)
+        g_array_index (col, guint32, word) |= 1u << (y % 32);
+    else
+        g_array_index (col, guint32, word) &= ~(1u << (y % 32));
+}
+
+static gboolean
+grid_cell_used (Paxui *paxui, gint x, gint y)
+{
+    GArray *col;
+    guint word;
+
+    if (y < 0 || (col = grid_column (paxui, x)) == NULL) return FALSE;
+
+    word = y / 32;
+    if (word >= col->len) return FALSE;
+
+    return (g_array_index (col, guint32, word) >> (y % 32)) & 1;
+}
+
+/* first free row in column x at or below row y */
+static gint
+grid_first_free (Paxui *paxui, gint x, gint y)
+{
+    GArray *col;
+    guint word;
+    guint32 bits;
+
+    if (y < 0 || (col = grid_column (paxui, x)) == NULL) return y;
+
+    for (word = y / 32; word < col->len; word++)
+    {
+        bits = ~g_array_index (col, guint32, word);
+        if (word == y / 32) bits &= ~0u << (y % 32);
+
+        if (bits) return word * 32 + g_bit_nth_lsf (bits, -1);
+    }
+
+    return MAX (y, (gint) col->len * 32);
+}
+
+static void edge_cache_refresh (Paxui *paxui);
+
+/* mark cached line end points stale, they're rebuilt on next refresh */
+static void
+edge_cache_invalidate (Paxui *paxui)
+{
+    paxui->edges_valid = FALSE;
+}
+
+/* queue redraw of an area given in layout content coords; with edges
+ * set, the area of the cached edge layer is re-rendered as well */
+static void
+layout_damage_rect (Paxui *paxui, const GdkRectangle *rect, gboolean edges)
+{
+    GtkAdjustment *h, *v;
+    gint x, y;
+
+    if (rect->width <= 0 || rect->height <= 0) return;
+
+    if (edges)
+    {
+        if (paxui->edge_damage == NULL) paxui->edge_damage = cairo_region_create ();
+        cairo_region_union_rectangle (paxui->edge_damage, rect);
+    }
+
+    h = gtk_scrollable_get_hadjustment (GTK_SCROLLABLE (paxui->layout));
+    v = gtk_scrollable_get_vadjustment (GTK_SCROLLABLE (paxui->layout));
+    x = rect->x - (gint) gtk_adjustment_get_value (h);
+    y = rect->y - (gint) gtk_adjustment_get_value (v);
+
+    gtk_widget_queue_draw_area (paxui->layout, x, y, rect->width, rect->height);
+}
+
+static void
+layout_damage_drop_zone (Paxui *paxui)
+{
+    GdkRectangle rect;
+
+    if (paxui->drop_y < 1) return;
+
+    rect.x = paxui->drop_x - PAXUI_LINE_WIDTH;
+    rect.y = paxui->drop_y - PAXUI_LINE_WIDTH;
+    rect.width  = paxui->drop_w + 2 * PAXUI_LINE_WIDTH;
+    rect.height = paxui->drop_h + 2 * PAXUI_LINE_WIDTH;
+
+    layout_damage_rect (paxui, &rect, FALSE);
+}
+
 static void
 add_new_row (Paxui *paxui)
 {
@@ -75,7 +196,8 @@ add_new_row (Paxui *paxui)
     gtk_widget_set_valign (label, GTK_ALIGN_START);
     gtk_style_context_add_class (gtk_widget_get_style_context (label), "dummy");
     gtk_size_group_add_widget (GTK_SIZE_GROUP (paxui->size_group), label);
-    gtk_grid_attach (GTK_GRID (paxui->grid), label, PAXUI_COL_DUMMY, paxui->end_row++, 1, 1);
+    gtk_grid_attach (GTK_GRID (paxui->grid), label, PAXUI_COL_DUMMY, paxui->end_row, 1, 1);
+    grid_cell_set (paxui, PAXUI_COL_DUMMY, paxui->end_row++, TRUE);
     gtk_widget_show (label);
 }
 
@@ -137,10 +259,17 @@ get_new_colour (Paxui *paxui)
 static void
 leaf_grid_reattach (PaxuiLeaf *leaf)
 {
-    if (leaf == NULL || leaf->outer == NULL) return;
+    gboolean floating;
+
+    if (leaf == NULL || leaf->view == NULL) return;
+
+    /* new widgets are attached straight from their floating ref */
+    floating = g_object_is_floating (leaf->view->outer);
+    gtk_grid_attach (GTK_GRID (leaf->paxui->grid), leaf->view->outer, leaf->x, leaf->y, 1, 1);
+    if (!floating) g_object_unref (leaf->view->outer);
 
-    gtk_grid_attach (GTK_GRID (leaf->paxui->grid), leaf->outer, leaf->x, leaf->y, 1, 1);
-    g_object_unref (leaf->outer);
+    grid_cell_set (leaf->paxui, leaf->x, leaf->y, TRUE);
+    leaf->view->att_y = leaf->y;
 
     while (leaf->paxui->end_row - leaf->y <= 4) add_new_row (leaf->paxui);
 }
@@ -150,11 +279,16 @@ leaf_grid_detach (PaxuiLeaf *leaf)
 {
     GtkWidget *parent;
 
-    if (leaf == NULL || leaf->outer == NULL) return;
+    if (leaf == NULL || leaf->view == NULL) return;
 
-    g_object_ref (leaf->outer);
-    if ((parent = gtk_widget_get_parent (leaf->outer)))
-        gtk_container_remove (GTK_CONTAINER (parent), leaf->outer);
+    if ((parent = gtk_widget_get_parent (leaf->view->outer)))
+    {
+        g_object_ref (leaf->view->outer);
+        gtk_container_remove (GTK_CONTAINER (parent), leaf->view->outer);
+
+        grid_cell_set (leaf->paxui, leaf->x, leaf->view->att_y, FALSE);
+        leaf->view->att_y = 0;
+    }
 }
 
 static void
@@ -312,8 +446,8 @@ grid_drag_leave (GtkWidget *layout, GdkDragContext *context, guint time, gpointe
 
     if (leaf->paxui->drop_y < 1) return;
 
+    layout_damage_drop_zone (leaf->paxui);
     leaf->paxui->drop_y = -1;
-    gtk_widget_queue_draw (leaf->paxui->layout);
 }
 
 static gboolean
@@ -345,6 +479,7 @@ grid_drag_drop (GtkWidget *layout, GdkDragContext *context, gint x, gint y, guin
         default:
             leaf->y = target_row;
             leaf_grid_attach (leaf);
+            paxui_gui_touch_leaf (leaf);
     }
 
     paxui_gui_trigger_update (leaf->paxui);
@@ -405,18 +540,23 @@ grid_drag_motion (GtkWidget *layout, GdkDragContext *context, gint x, gint y, gu
     DBG("  returning valid:%d", valid);
 
     old_y = leaf->paxui->drop_y;
-    if (valid)
-    {
-        leaf->paxui->drop_x = alloc.x;
-        leaf->paxui->drop_y = alloc.y;
-        leaf->paxui->drop_w = alloc.width;
-        leaf->paxui->drop_h = alloc.height;
-    }
-    else
+    if ((valid ? alloc.y : -1) != old_y)
     {
-        leaf->paxui->drop_y = -1;
+        /* old & new drop zone areas */
+        layout_damage_drop_zone (leaf->paxui);
+        if (valid)
+        {
+            leaf->paxui->drop_x = alloc.x;
+            leaf->paxui->drop_y = alloc.y;
+            leaf->paxui->drop_w = alloc.width;
+            leaf->paxui->drop_h = alloc.height;
+        }
+        else
+        {
+            leaf->paxui->drop_y = -1;
+        }
+        layout_damage_drop_zone (leaf->paxui);
     }
-    if (leaf->paxui->drop_y != old_y) gtk_widget_queue_draw (leaf->paxui->layout);
 
     return valid;
 }
@@ -447,18 +587,18 @@ slider_value_cb (GtkRange *range, gpointer udata)
 
     DBG("slider changed v:%f l:%u", value, level);
 
-    if (gtk_toggle_button_get_active (GTK_TOGGLE_BUTTON (leaf->lock_button)))
+    if (gtk_toggle_button_get_active (GTK_TOGGLE_BUTTON (leaf->view->lock_button)))
     {
-        for (i = 0; i < leaf->n_chan; i++)
-            leaf->levels[i] = level;
+        for (i = 0; i < leaf->vol->n_chan; i++)
+            leaf->vol->levels[i] = level;
     }
     else
     {
-        for (i = 0; i < leaf->n_chan; i++)
-            if (leaf->sliders[i] == GTK_WIDGET (range))
+        for (i = 0; i < leaf->vol->n_chan; i++)
+            if (leaf->view->sliders[i] == GTK_WIDGET (range))
             {
                 DBG("    chan:%u changed", i);
-                leaf->levels[i] = level;
+                leaf->vol->levels[i] = level;
                 break;
             }
     }
@@ -466,22 +606,30 @@ slider_value_cb (GtkRange *range, gpointer udata)
     paxui_pulse_volume_set (leaf);
 }
 
+static gboolean
+slider_release_cb (GtkWidget *slider, GdkEvent *event, gpointer udata)
+{
+    paxui_pulse_volume_flush (udata);
+
+    return FALSE;
+}
+
 static void
 lock_button_set (PaxuiLeaf *leaf)
 {
     GtkWidget *image;
 
-    image = gtk_button_get_image (GTK_BUTTON (leaf->lock_button));
+    image = gtk_button_get_image (GTK_BUTTON (leaf->view->lock_button));
 
-    if (gtk_toggle_button_get_active (GTK_TOGGLE_BUTTON (leaf->lock_button)))
+    if (gtk_toggle_button_get_active (GTK_TOGGLE_BUTTON (leaf->view->lock_button)))
     {
         gtk_image_set_from_pixbuf (GTK_IMAGE (image), leaf->paxui->icons[PX_ICON_LOCKED]);
-        gtk_widget_set_tooltip_text (leaf->lock_button, "Channels locked to same level");
+        gtk_widget_set_tooltip_text (leaf->view->lock_button, "Channels locked to same level");
     }
     else
     {
         gtk_image_set_from_pixbuf (GTK_IMAGE (image), leaf->paxui->icons[PX_ICON_UNLOCKED]);
-        gtk_widget_set_tooltip_text (leaf->lock_button, "Channels independent");
+        gtk_widget_set_tooltip_text (leaf->view->lock_button, "Channels independent");
     }
 }
 
@@ -491,22 +639,22 @@ mute_button_set (PaxuiLeaf *leaf)
     guint i;
     GtkWidget *image;
 
-    gtk_toggle_button_set_active (GTK_TOGGLE_BUTTON (leaf->mute_button), leaf->muted);
+    gtk_toggle_button_set_active (GTK_TOGGLE_BUTTON (leaf->view->mute_button), leaf->muted);
 
-    image = gtk_button_get_image (GTK_BUTTON (leaf->mute_button));
+    image = gtk_button_get_image (GTK_BUTTON (leaf->view->mute_button));
     if (leaf->muted)
     {
         gtk_image_set_from_pixbuf (GTK_IMAGE (image), leaf->paxui->icons[PX_ICON_MUTED]);
-        gtk_widget_set_tooltip_text (leaf->mute_button, "All channels muted");
+        gtk_widget_set_tooltip_text (leaf->view->mute_button, "All channels muted");
     }
     else
     {
         gtk_image_set_from_pixbuf (GTK_IMAGE (image), leaf->paxui->icons[PX_ICON_UNMUTED]);
-        gtk_widget_set_tooltip_text (leaf->mute_button, "All channels unmuted");
+        gtk_widget_set_tooltip_text (leaf->view->mute_button, "All channels unmuted");
     }
 
-    for (i = 0; i < leaf->n_chan; i++)
-        gtk_widget_set_sensitive (leaf->sliders[i], !leaf->muted);
+    for (i = 0; i < leaf->vol->n_chan; i++)
+        gtk_widget_set_sensitive (leaf->view->sliders[i], !leaf->muted);
 }
 
 static void
@@ -537,32 +685,38 @@ mute_button_cb (GtkToggleButton *button, gpointer udata)
     }
 }
 
+static void
+leaf_set_mute (PaxuiLeaf *leaf)
+{
+    if (leaf->view == NULL || leaf->view->sliders == NULL) return;
+
+    DBG("set mute, m:%d", leaf->muted);
+
+    g_signal_handlers_block_by_func (leaf->view->mute_button, mute_button_cb, leaf);
+    mute_button_set (leaf);
+    g_signal_handlers_unblock_by_func (leaf->view->mute_button, mute_button_cb, leaf);
+}
+
 static void
 leaf_set_volume (PaxuiLeaf *leaf)
 {
     guint i;
 
-    if (leaf->sliders == NULL) return;
+    if (leaf->view == NULL || leaf->view->sliders == NULL) return;
 
-    DBG("set volume, m:%d", leaf->muted);
+    DBG("set volume");
 
-    g_signal_handlers_block_by_func (leaf->mute_button, mute_button_cb, leaf);
-    mute_button_set (leaf);
-    g_signal_handlers_unblock_by_func (leaf->mute_button, mute_button_cb, leaf);
-
-    for (i = 0; i < leaf->n_chan; i++)
+    for (i = 0; i < leaf->vol->n_chan; i++)
     {
         gdouble level;
 
-        level = volume_uint_to_double (leaf->levels[i]);
+        level = volume_uint_to_double (leaf->vol->levels[i]);
 
-        DBG("    l:%d v:%f", leaf->levels[i], level);
+        DBG("    l:%d v:%f", leaf->vol->levels[i], level);
 
-        g_signal_handlers_block_by_func (leaf->sliders[i], slider_value_cb, leaf);
-        gtk_range_set_value (GTK_RANGE (leaf->sliders[i]), level);
-        g_signal_handlers_unblock_by_func (leaf->sliders[i], slider_value_cb, leaf);
-
-        gtk_widget_set_sensitive (leaf->sliders[i], !leaf->muted);
+        g_signal_handlers_block_by_func (leaf->view->sliders[i], slider_value_cb, leaf);
+        gtk_range_set_value (GTK_RANGE (leaf->view->sliders[i]), level);
+        g_signal_handlers_unblock_by_func (leaf->view->sliders[i], slider_value_cb, leaf);
     }
 }
 
@@ -577,7 +731,7 @@ tool_slider_new (PaxuiLeaf *leaf, GtkBox *sbox, guint index)
     gtk_box_pack_start (sbox, vbox, FALSE, FALSE, 0);
 
     adj = gtk_adjustment_new (
-                volume_uint_to_double (leaf->levels[index]), 0., 100., 1., 1., 0.);
+                volume_uint_to_double (leaf->vol->levels[index]), 0., 100., 1., 1., 0.);
     slider = gtk_scale_new (GTK_ORIENTATION_VERTICAL, adj);
     gtk_range_set_inverted (GTK_RANGE (slider), TRUE);
     gtk_range_set_round_digits (GTK_RANGE (slider), 0);
@@ -593,7 +747,7 @@ tool_slider_new (PaxuiLeaf *leaf, GtkBox *sbox, guint index)
                 GTK_POS_LEFT,
                 (leaf->paxui->tist_enabled ? "10" : "100"));
     }
-    else if (index == leaf->n_chan - 1)
+    else if (index == leaf->vol->n_chan - 1)
     {
         gtk_scale_add_mark (GTK_SCALE (slider), 0., GTK_POS_RIGHT, "0");
         gtk_scale_add_mark (GTK_SCALE (slider),
@@ -603,27 +757,68 @@ tool_slider_new (PaxuiLeaf *leaf, GtkBox *sbox, guint index)
     }
     gtk_box_pack_start (GTK_BOX (vbox), slider, FALSE, FALSE, 0);
 
-    label = gtk_label_new (paxui_pulse_channel_str (leaf->positions[index]));
+    label = gtk_label_new (paxui_pulse_channel_str (leaf->vol->positions[index]));
     gtk_label_set_angle (GTK_LABEL (label), 90);
     gtk_style_context_add_class (gtk_widget_get_style_context (label), "channel");
     if (index == 0)
         gtk_widget_set_halign (label, GTK_ALIGN_END);
-    else if (index == leaf->n_chan - 1)
+    else if (index == leaf->vol->n_chan - 1)
         gtk_widget_set_halign (label, GTK_ALIGN_START);
 
     gtk_box_pack_start (GTK_BOX (vbox), label, FALSE, FALSE, 0);
 
     g_signal_connect (slider, "value-changed", G_CALLBACK (slider_value_cb), leaf);
+    g_signal_connect (slider, "button-release-event", G_CALLBACK (slider_release_cb), leaf);
+
+    leaf->view->sliders[index] = slider;
+}
+
+static gboolean tool_popover_expire (gpointer udata);
 
-    leaf->sliders[index] = slider;
+static void
+tool_popover_closed_cb (GtkWidget *popover, PaxuiLeaf *leaf)
+{
+    if (leaf->view->popover_src) g_source_remove (leaf->view->popover_src);
+    leaf->view->popover_src = g_timeout_add_seconds (PAXUI_POPOVER_IDLE, tool_popover_expire, leaf);
 }
 
+/* free the tool popover & its sliders, built again on next click */
 static void
-tool_clicked_cb (GtkWidget *button, PaxuiLeaf *leaf)
+tool_popover_free (PaxuiLeaf *leaf)
 {
-    DBG("tool clicked");
+    if (leaf->view->popover_src)
+    {
+        g_source_remove (leaf->view->popover_src);
+        leaf->view->popover_src = 0;
+    }
 
-    if (leaf->popover) gtk_popover_popup (GTK_POPOVER (leaf->popover));
+    if (leaf->view->popover == NULL) return;
+
+    if (leaf->view->lock_button)
+        leaf->view->locked = gtk_toggle_button_get_active (GTK_TOGGLE_BUTTON (leaf->view->lock_button));
+
+    /* no idle timer from the close on destroy */
+    g_signal_handlers_disconnect_by_func (leaf->view->popover, tool_popover_closed_cb, leaf);
+    gtk_widget_destroy (leaf->view->popover);
+    leaf->view->popover = NULL;
+    leaf->view->mute_button = NULL;
+    leaf->view->lock_button = NULL;
+
+    g_free (leaf->view->sliders);
+    leaf->view->sliders = NULL;
+}
+
+static gboolean
+tool_popover_expire (gpointer udata)
+{
+    PaxuiLeaf *leaf = udata;
+
+    DBG("tool popover unused, freeing");
+
+    leaf->view->popover_src = 0;
+    tool_popover_free (leaf);
+
+    return G_SOURCE_REMOVE;
 }
 
 static void
@@ -635,11 +830,12 @@ build_tool_popover (PaxuiLeaf *leaf)
 
     DBG("build tool");
 
-    leaf->popover = gtk_popover_new (leaf->tool_button);
-    gtk_container_set_border_width (GTK_CONTAINER (leaf->popover), 4);
+    leaf->view->popover = gtk_popover_new (leaf->view->tool_button);
+    gtk_container_set_border_width (GTK_CONTAINER (leaf->view->popover), 4);
+    g_signal_connect (leaf->view->popover, "closed", G_CALLBACK (tool_popover_closed_cb), leaf);
 
     obox = gtk_box_new (GTK_ORIENTATION_VERTICAL, 4);
-    gtk_container_add (GTK_CONTAINER (leaf->popover), obox);
+    gtk_container_add (GTK_CONTAINER (leaf->view->popover), obox);
 
     if (!leaf->vol_enabled) goto skip_volume;
 
@@ -650,8 +846,8 @@ build_tool_popover (PaxuiLeaf *leaf)
     sbox = gtk_box_new (GTK_ORIENTATION_HORIZONTAL, 4);
     gtk_box_pack_start (GTK_BOX (hbox), sbox, FALSE, FALSE, 0);
 
-    leaf->sliders = g_new (GtkWidget *, leaf->n_chan);
-    for (i = 0; i < leaf->n_chan; i++)
+    leaf->view->sliders = g_new (GtkWidget *, leaf->vol->n_chan);
+    for (i = 0; i < leaf->vol->n_chan; i++)
     {
         tool_slider_new (leaf, GTK_BOX (sbox), i);
     }
@@ -660,17 +856,18 @@ build_tool_popover (PaxuiLeaf *leaf)
     gtk_widget_set_valign (vbox, GTK_ALIGN_CENTER);
     gtk_box_pack_start (GTK_BOX (hbox), vbox, FALSE, FALSE, 0);
 
-    leaf->mute_button = gtk_toggle_button_new ();
-    gtk_button_set_image (GTK_BUTTON (leaf->mute_button), gtk_image_new ());
+    leaf->view->mute_button = gtk_toggle_button_new ();
+    gtk_button_set_image (GTK_BUTTON (leaf->view->mute_button), gtk_image_new ());
     mute_button_set (leaf);
-    gtk_box_pack_start (GTK_BOX (vbox), leaf->mute_button, FALSE, FALSE, 0);
-    g_signal_connect (leaf->mute_button, "toggled", G_CALLBACK (mute_button_cb), leaf);
+    gtk_box_pack_start (GTK_BOX (vbox), leaf->view->mute_button, FALSE, FALSE, 0);
+    g_signal_connect (leaf->view->mute_button, "toggled", G_CALLBACK (mute_button_cb), leaf);
 
-    leaf->lock_button = gtk_toggle_button_new ();
-    gtk_button_set_image (GTK_BUTTON (leaf->lock_button), gtk_image_new ());
+    leaf->view->lock_button = gtk_toggle_button_new ();
+    gtk_button_set_image (GTK_BUTTON (leaf->view->lock_button), gtk_image_new ());
+    gtk_toggle_button_set_active (GTK_TOGGLE_BUTTON (leaf->view->lock_button), leaf->view->locked);
     lock_button_set (leaf);
-    gtk_box_pack_start (GTK_BOX (vbox), leaf->lock_button, FALSE, FALSE, 0);
-    g_signal_connect (leaf->lock_button, "toggled", G_CALLBACK (lock_button_cb), leaf);
+    gtk_box_pack_start (GTK_BOX (vbox), leaf->view->lock_button, FALSE, FALSE, 0);
+    g_signal_connect (leaf->view->lock_button, "toggled", G_CALLBACK (lock_button_cb), leaf);
 
     tools_added = TRUE;
 
@@ -684,40 +881,58 @@ skip_volume:
     }
     else
     {
-        gtk_widget_destroy (leaf->popover);
-        leaf->popover = NULL;
-        gtk_widget_set_sensitive (leaf->tool_button, FALSE);
+        gtk_widget_destroy (leaf->view->popover);
+        leaf->view->popover = NULL;
+        gtk_widget_set_sensitive (leaf->view->tool_button, FALSE);
+    }
+}
+
+static void
+tool_clicked_cb (GtkWidget *button, PaxuiLeaf *leaf)
+{
+    DBG("tool clicked");
+
+    if (leaf->view->popover_src)
+    {
+        g_source_remove (leaf->view->popover_src);
+        leaf->view->popover_src = 0;
     }
+
+    /* built on first use */
+    if (leaf->view->popover == NULL) build_tool_popover (leaf);
+
+    if (leaf->view->popover) gtk_popover_popup (GTK_POPOVER (leaf->view->popover));
 }
 
 static void
 leaf_set_label (PaxuiLeaf *leaf)
 {
-    if (leaf->label == NULL) return;
+    if (leaf->view == NULL) return;
 
     switch (leaf->leaf_type)
     {
         gchar *txt;
         GString *str;
-        gchar *p;
+        const gchar *p;
 
         case PAXUI_LEAF_TYPE_MODULE:
+            gtk_widget_set_tooltip_text (leaf->view->outer, leaf->utf8_name);
             p = (leaf->utf8_name && g_str_has_prefix (leaf->utf8_name, "module-")
                     ? leaf->utf8_name + 7 : leaf->utf8_name);
             txt = g_markup_printf_escaped (
                             "%s\n<small>module #%u</small>",
                             (p ? p : ""),
                             leaf->index);
-            gtk_label_set_markup (GTK_LABEL (leaf->label), txt);
+            gtk_label_set_markup (GTK_LABEL (leaf->view->label), txt);
             g_free (txt);
             break;
         case PAXUI_LEAF_TYPE_CLIENT:
-            gtk_widget_set_tooltip_text (leaf->outer, leaf->utf8_name);
+            gtk_widget_set_tooltip_text (leaf->view->outer, leaf->utf8_name);
             txt = g_markup_printf_escaped (
                             "%s\n<small>client #%u</small>",
-                            leaf->short_name,
+                            (leaf->short_name ? leaf->short_name : ""),
                             leaf->index);
-            gtk_label_set_markup (GTK_LABEL (leaf->label), txt);
+            gtk_label_set_markup (GTK_LABEL (leaf->view->label), txt);
             g_free (txt);
             break;
         case PAXUI_LEAF_TYPE_SOURCE:
@@ -731,7 +946,7 @@ leaf_set_label (PaxuiLeaf *leaf)
                             str->str,
                             (leaf->monitor != G_MAXUINT ? "monitor " : ""),
                             leaf->index);
-            gtk_label_set_markup (GTK_LABEL (leaf->label), txt);
+            gtk_label_set_markup (GTK_LABEL (leaf->view->label), txt);
 
             g_string_free (str, TRUE);
             g_free (txt);
@@ -746,7 +961,7 @@ leaf_set_label (PaxuiLeaf *leaf)
                             "%s\n<small>#%u</small>",
                             str->str,
                             leaf->index);
-            gtk_label_set_markup (GTK_LABEL (leaf->label), txt);
+            gtk_label_set_markup (GTK_LABEL (leaf->view->label), txt);
 
             g_string_free (str, TRUE);
             g_free (txt);
@@ -755,7 +970,7 @@ leaf_set_label (PaxuiLeaf *leaf)
         case PAXUI_LEAF_TYPE_SINK_INPUT:
             txt = g_strdup_printf ("%s\n#%u", leaf->short_name, leaf->index);
 
-            gtk_label_set_text (GTK_LABEL (leaf->label), txt);
+            gtk_label_set_text (GTK_LABEL (leaf->view->label), txt);
             g_free (txt);
             break;
     }
@@ -787,15 +1002,47 @@ label_style_updated (GtkWidget *label, gpointer udata)
 }
 
 
+/* saved items are queued per interned name in saved order, so leaves
+ * sharing a name take their positions in turn */
+static void
+init_index_add (GHashTable *items, PaxuiName *key, PaxuiInitItem *irec)
+{
+    GQueue *queue;
+
+    if ((queue = g_hash_table_lookup (items, key)) == NULL)
+    {
+        queue = g_queue_new ();
+        g_hash_table_insert (items, key, queue);
+    }
+
+    g_queue_push_tail (queue, irec);
+}
+
+/* next saved item with a position for key */
+static PaxuiInitItem *
+init_index_take (GHashTable *items, PaxuiName *key)
+{
+    GQueue *queue;
+    PaxuiInitItem *irec;
+
+    if (items == NULL || (queue = g_hash_table_lookup (items, key)) == NULL) return NULL;
+
+    while ((irec = g_queue_pop_head (queue)))
+    {
+        if (irec->y > 0) return irec;
+    }
+
+    return NULL;
+}
+
 static void
 position_to_init_column (Paxui *paxui, GList *column, GList *init_list)
 {
     gint y;
     GList *lc, *li;
+    GHashTable *singles, *pairs;
     PaxuiLeaf *leaf;
 
-    if (init_list == NULL) return;
-
     /* detach all in column & clear y coords */
     for (lc = column; lc; lc = lc->next)
     {
@@ -804,50 +1051,69 @@ position_to_init_column (Paxui *paxui, GList *column, GList *init_list)
         leaf->y = 0;
     }
 
-    /* set y coord for items matched to init_list */
+    /* index init_list by interned name, or module then client name;
+     * names not interned belong to no live leaf */
+    singles = g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL, (GDestroyNotify) g_queue_free);
+    pairs = g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL, (GDestroyNotify) g_hash_table_unref);
+
     for (li = init_list; li; li = li->next)
     {
         PaxuiInitItem *irec = li->data;
+        PaxuiName *pn1, *pn2;
+        GHashTable *clients;
+
+        if ((pn1 = paxui_name_lookup (paxui, irec->str1)) == NULL) continue;
 
-        for (lc = column; lc; lc = lc->next)
+        if (irec->str2 == NULL)
         {
-            leaf = lc->data;
+            init_index_add (singles, pn1, irec);
+            continue;
+        }
 
-            if (leaf->y) continue;
+        if ((pn2 = paxui_name_lookup (paxui, irec->str2)) == NULL) continue;
 
-            if (irec->str2)
-            {
-                PaxuiLeaf *module;
-
-                module = paxui_find_module_for_index (paxui, leaf->module);
-                if (module == NULL || irec->str1 == NULL ||
-                    strcmp (irec->str1, module->name) || strcmp (irec->str2, leaf->name))
-                {
-                    continue;
-                }
-            }
-            else if (irec->str1 == NULL || strcmp (irec->str1, leaf->name))
-            {
-                continue;
-            }
+        if ((clients = g_hash_table_lookup (pairs, pn1)) == NULL)
+        {
+            clients = g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL, (GDestroyNotify) g_queue_free);
+            g_hash_table_insert (pairs, pn1, clients);
+        }
+        init_index_add (clients, pn2, irec);
+    }
+
+    /* set y coord for leaves matched to init_list */
+    for (lc = column; lc; lc = lc->next)
+    {
+        PaxuiInitItem *irec = NULL;
+        PaxuiLeaf *module;
 
-            if (irec->y > 0) leaf->y = irec->y;
+        leaf = lc->data;
+        if (leaf->pname == NULL) continue;
 
-            break;
+        if (g_hash_table_size (pairs) &&
+            (module = paxui_find_module_for_index (paxui, leaf->module)) && module->pname)
+        {
+            irec = init_index_take (g_hash_table_lookup (pairs, module->pname), leaf->pname);
         }
+        if (irec == NULL)
+            irec = init_index_take (singles, leaf->pname);
+
+        if (irec) leaf->y = irec->y;
     }
 
+    g_hash_table_destroy (singles);
+    g_hash_table_destroy (pairs);
+
     /* attach any leaf with specified position that's free */
     for (lc = column, y = 1; lc; lc = lc->next)
     {
         leaf = lc->data;
 
         if (leaf->y > 0 &&
-            gtk_grid_get_child_at (GTK_GRID (paxui->grid), leaf->x, leaf->y) == NULL)
+            !grid_cell_used (paxui, leaf->x, leaf->y))
         {
             y = leaf->y + 1;
             leaf_grid_reattach (leaf);
-            gtk_widget_queue_draw (leaf->outer);
+            gtk_widget_queue_draw (leaf->view->outer);
         }
         else
         {
@@ -861,36 +1127,17 @@ position_to_init_column (Paxui *paxui, GList *column, GList *init_list)
 
         if (leaf->y > 0) continue;
 
-        while (gtk_grid_get_child_at (GTK_GRID (paxui->grid), leaf->x, y)) y++;
+        y = grid_first_free (paxui, leaf->x, y);
 
         leaf->y = y++;
         leaf_grid_reattach (leaf);
-        gtk_widget_queue_draw (leaf->outer);
+        gtk_widget_queue_draw (leaf->view->outer);
     }
 }
 
 static gboolean
-position_to_init_full (gpointer udata)
-{
-    Paxui *paxui = udata;
-
-    DBG("full repos to init states");
-
-    position_to_init_column (paxui, paxui->sources, paxui->src_inits);
-    position_to_init_column (paxui, paxui->acams, paxui->cam_inits);
-    position_to_init_column (paxui, paxui->sinks, paxui->snk_inits);
-
-    paxui_unload_init_strings (paxui);
-
-    return G_SOURCE_REMOVE;
-}
-
-
-static void
-leaf_set_initial_pos (PaxuiLeaf *leaf)
+leaf_set_column (PaxuiLeaf *leaf)
 {
-    gint y;
-
     switch (leaf->leaf_type)
     {
         case PAXUI_LEAF_TYPE_SOURCE:
@@ -910,18 +1157,27 @@ leaf_set_initial_pos (PaxuiLeaf *leaf)
             leaf->x = PAXUI_COL_SINKS;
             break;
         default:
-            return;
+            return FALSE;
     }
+    return TRUE;
+}
 
-    for (y = 1; ; y++)
-    {
-        if (gtk_grid_get_child_at (GTK_GRID (leaf->paxui->grid), leaf->x, y) == NULL)
-        {
-            leaf->y = y;
-            leaf_grid_attach (leaf);
-            return;
-        }
-    }
+static void
+leaf_attach_free_row (PaxuiLeaf *leaf)
+{
+    leaf->y = grid_first_free (leaf->paxui, leaf->x, 1);
+    leaf_grid_attach (leaf);
+}
+
+static void
+leaf_set_initial_pos (PaxuiLeaf *leaf)
+{
+    if (!leaf_set_column (leaf)) return;
+
+    /* initial load places everything in one pass afterwards */
+    if (leaf->paxui->populating) return;
+
+    leaf_attach_free_row (leaf);
 }
 
 static void
@@ -933,12 +1189,116 @@ tool_button_add (PaxuiLeaf *leaf, GtkWidget *hbox)
     gtk_widget_set_valign (vbox, GTK_ALIGN_CENTER);
     gtk_box_pack_start (GTK_BOX (hbox), vbox, FALSE, FALSE, 0);
 
-    leaf->tool_button = gtk_button_new ();
+    leaf->view->tool_button = gtk_button_new ();
     image = gtk_image_new_from_pixbuf (leaf->paxui->icons[PX_ICON_GEAR]);
-    gtk_button_set_image (GTK_BUTTON (leaf->tool_button), image);
-    gtk_container_add (GTK_CONTAINER (vbox), leaf->tool_button);
+    gtk_button_set_image (GTK_BUTTON (leaf->view->tool_button), image);
+    gtk_container_add (GTK_CONTAINER (vbox), leaf->view->tool_button);
+
+    /* volume is the only tool so far */
+    gtk_widget_set_sensitive (leaf->view->tool_button, leaf->vol_enabled);
+
+    g_signal_connect (leaf->view->tool_button, "clicked", G_CALLBACK (tool_clicked_cb), leaf);
+}
 
-    g_signal_connect (leaf->tool_button, "clicked", G_CALLBACK (tool_clicked_cb), leaf);
+/* so/si come & go in bursts; their outer widgets are kept in a pool
+ * on destroy and handed to the next new leaf of that type */
+static gboolean
+leaf_type_pooled (guint leaf_type)
+{
+    return leaf_type == PAXUI_LEAF_TYPE_SOURCE_OUTPUT ||
+           leaf_type == PAXUI_LEAF_TYPE_SINK_INPUT;
+}
+
+static gboolean
+leaf_gui_pool_put (PaxuiLeaf *leaf)
+{
+    Paxui *paxui = leaf->paxui;
+    GtkWidget *parent;
+    GQueue *pool;
+
+    if (!leaf_type_pooled (leaf->leaf_type)) return FALSE;
+
+    if ((pool = paxui->widget_pool[leaf->leaf_type]) == NULL)
+        pool = paxui->widget_pool[leaf->leaf_type] = g_queue_new ();
+
+    if (g_queue_get_length (pool) >= PAXUI_POOL_MAX) return FALSE;
+
+    /* strip everything tied to this leaf */
+    tool_popover_free (leaf);
+    g_signal_handlers_disconnect_by_data (leaf->view->tool_button, leaf);
+    g_object_set_data (G_OBJECT (leaf->view->outer), "leaf", NULL);
+
+    /* pool holds its own ref */
+    g_object_ref (leaf->view->outer);
+    if ((parent = gtk_widget_get_parent (leaf->view->outer)))
+        gtk_container_remove (GTK_CONTAINER (parent), leaf->view->outer);
+    gtk_size_group_remove_widget (GTK_SIZE_GROUP (paxui->size_group), leaf->view->outer);
+
+    g_queue_push_head (pool, leaf->view->outer);
+
+    leaf->view->outer = NULL;
+    leaf->view->label = NULL;
+    leaf->view->tool_button = NULL;
+
+    return TRUE;
+}
+
+static gboolean
+leaf_gui_pool_get (PaxuiLeaf *leaf)
+{
+    Paxui *paxui = leaf->paxui;
+    GQueue *pool;
+
+    if (!leaf_type_pooled (leaf->leaf_type)) return FALSE;
+
+    pool = paxui->widget_pool[leaf->leaf_type];
+    if (pool == NULL || g_queue_is_empty (pool))
+    {
+        paxui->pool_misses++;
+        TRACE("widget pool miss, hits:%u misses:%u", paxui->pool_hits, paxui->pool_misses);
+        return FALSE;
+    }
+
+    paxui->pool_hits++;
+    TRACE("widget pool hit, hits:%u misses:%u", paxui->pool_hits, paxui->pool_misses);
+
+    leaf->view->outer = g_queue_pop_head (pool);
+    leaf->view->label = g_object_get_data (G_OBJECT (leaf->view->outer), "label");
+    leaf->view->tool_button = g_object_get_data (G_OBJECT (leaf->view->outer), "tool-button");
+
+    g_object_set_data (G_OBJECT (leaf->view->outer), "leaf", leaf);
+    gtk_widget_set_tooltip_text (leaf->view->outer, leaf->utf8_name);
+    if (!paxui->populating)
+        gtk_size_group_add_widget (GTK_SIZE_GROUP (paxui->size_group), leaf->view->outer);
+
+    leaf_set_label (leaf);
+
+    gtk_widget_set_sensitive (leaf->view->tool_button, leaf->vol_enabled);
+    g_signal_connect (leaf->view->tool_button, "clicked", G_CALLBACK (tool_clicked_cb), leaf);
+
+    return TRUE;
+}
+
+void
+paxui_gui_free_pools (Paxui *paxui)
+{
+    GtkWidget *outer;
+    guint type;
+
+    DBG("widget pool hits:%u misses:%u", paxui->pool_hits, paxui->pool_misses);
+
+    for (type = 0; type < PAXUI_LEAF_NUM_TYPES; type++)
+    {
+        if (paxui->widget_pool[type] == NULL) continue;
+
+        while ((outer = g_queue_pop_head (paxui->widget_pool[type])))
+        {
+            gtk_widget_destroy (outer);
+            g_object_unref (outer);
+        }
+        g_queue_free (paxui->widget_pool[type]);
+        paxui->widget_pool[type] = NULL;
+    }
 }
 
 void
@@ -946,26 +1306,39 @@ leaf_gui_new (PaxuiLeaf *leaf)
 {
     GtkWidget *hbox;
 
-    if (leaf == NULL || leaf->outer) return;
+    if (leaf == NULL || leaf->view) return;
+
+    /* widgets built from current state */
+    leaf->view = g_slice_new0 (PaxuiView);
+    leaf->dirty = 0;
+    paxui_leaf_update_owned (leaf);
+
+    if (leaf_gui_pool_get (leaf))
+    {
+        leaf_set_initial_pos (leaf);
+        gtk_widget_show_all (leaf->view->outer);
+        return;
+    }
 
-    leaf->outer = gtk_event_box_new ();
-    g_object_set_data (G_OBJECT (leaf->outer), "leaf", leaf);
-    gtk_widget_set_tooltip_text (leaf->outer, leaf->utf8_name);
-    gtk_widget_set_vexpand (leaf->outer, FALSE);
-    gtk_size_group_add_widget (GTK_SIZE_GROUP (leaf->paxui->size_group), leaf->outer);
-    gtk_style_context_add_class (gtk_widget_get_style_context (leaf->outer), "outer");
+    leaf->view->outer = gtk_event_box_new ();
+    g_object_set_data (G_OBJECT (leaf->view->outer), "leaf", leaf);
+    gtk_widget_set_tooltip_text (leaf->view->outer, leaf->utf8_name);
+    gtk_widget_set_vexpand (leaf->view->outer, FALSE);
+    if (!leaf->paxui->populating)
+        gtk_size_group_add_widget (GTK_SIZE_GROUP (leaf->paxui->size_group), leaf->view->outer);
+    gtk_style_context_add_class (gtk_widget_get_style_context (leaf->view->outer), "outer");
     if (leaf->paxui->dark_theme)
-        gtk_style_context_add_class (gtk_widget_get_style_context (leaf->outer), "dark");
+        gtk_style_context_add_class (gtk_widget_get_style_context (leaf->view->outer), "dark");
 
     hbox = gtk_box_new (GTK_ORIENTATION_HORIZONTAL, 4);
-    gtk_container_add (GTK_CONTAINER (leaf->outer), hbox);
+    gtk_container_add (GTK_CONTAINER (leaf->view->outer), hbox);
 
-    leaf->label = gtk_label_new (NULL);
-    gtk_label_set_xalign (GTK_LABEL (leaf->label), 0.);
-    gtk_label_set_line_wrap (GTK_LABEL (leaf->label), TRUE);
-    gtk_label_set_line_wrap_mode (GTK_LABEL (leaf->label), PANGO_WRAP_WORD_CHAR);
-    gtk_style_context_add_class (gtk_widget_get_style_context (leaf->label), "title");
-    g_signal_connect (leaf->label, "style-updated", G_CALLBACK (label_style_updated), leaf);
+    leaf->view->label = gtk_label_new (NULL);
+    gtk_label_set_xalign (GTK_LABEL (leaf->view->label), 0.);
+    gtk_label_set_line_wrap (GTK_LABEL (leaf->view->label), TRUE);
+    gtk_label_set_line_wrap_mode (GTK_LABEL (leaf->view->label), PANGO_WRAP_WORD_CHAR);
+    gtk_style_context_add_class (gtk_widget_get_style_context (leaf->view->label), "title");
+    g_signal_connect (leaf->view->label, "style-updated", G_CALLBACK (label_style_updated), leaf);
 
     leaf_set_label (leaf);
 
@@ -973,102 +1346,141 @@ leaf_gui_new (PaxuiLeaf *leaf)
     {
         case PAXUI_LEAF_TYPE_MODULE:
             leaf->paxui->acams = g_list_prepend (leaf->paxui->acams, leaf);
+            leaf->acam_link = leaf->paxui->acams;
 
             gtk_style_context_add_class (
-                    gtk_widget_get_style_context (leaf->outer), "module");
+                    gtk_widget_get_style_context (leaf->view->outer), "module");
 
-            gtk_box_pack_start (GTK_BOX (hbox), leaf->label, TRUE, TRUE, 0);
+            gtk_box_pack_start (GTK_BOX (hbox), leaf->view->label, TRUE, TRUE, 0);
 
-            gtk_drag_source_set (leaf->outer, GDK_BUTTON1_MASK, drop_target, 1, GDK_ACTION_MOVE);
-            gtk_drag_source_set_icon_pixbuf (leaf->outer, leaf->paxui->icons[PX_ICON_SWITCH]);
-            g_signal_connect (leaf->outer, "button-press-event", G_CALLBACK (paxui_actions_block_button_event), leaf);
+            gtk_drag_source_set (leaf->view->outer, GDK_BUTTON1_MASK, drop_target, 1, GDK_ACTION_MOVE);
+            gtk_drag_source_set_icon_pixbuf (leaf->view->outer, leaf->paxui->icons[PX_ICON_SWITCH]);
+            g_signal_connect (leaf->view->outer, "button-press-event", G_CALLBACK (paxui_actions_block_button_event), leaf);
             break;
         case PAXUI_LEAF_TYPE_CLIENT:
             leaf->paxui->acams = g_list_prepend (leaf->paxui->acams, leaf);
+            leaf->acam_link = leaf->paxui->acams;
 
             gtk_style_context_add_class (
-                    gtk_widget_get_style_context (leaf->outer), "client");
+                    gtk_widget_get_style_context (leaf->view->outer), "client");
 
-            gtk_box_pack_start (GTK_BOX (hbox), leaf->label, TRUE, TRUE, 0);
+            gtk_box_pack_start (GTK_BOX (hbox), leaf->view->label, TRUE, TRUE, 0);
 
-            gtk_drag_source_set (leaf->outer, GDK_BUTTON1_MASK, drop_target, 1, GDK_ACTION_MOVE);
-            gtk_drag_source_set_icon_pixbuf (leaf->outer, leaf->paxui->icons[PX_ICON_SWITCH]);
+            gtk_drag_source_set (leaf->view->outer, GDK_BUTTON1_MASK, drop_target, 1, GDK_ACTION_MOVE);
+            gtk_drag_source_set_icon_pixbuf (leaf->view->outer, leaf->paxui->icons[PX_ICON_SWITCH]);
             break;
         case PAXUI_LEAF_TYPE_SOURCE:
             gtk_style_context_add_class (
-                    gtk_widget_get_style_context (leaf->outer), "source");
+                    gtk_widget_get_style_context (leaf->view->outer), "source");
 
             tool_button_add (leaf, hbox);
-            build_tool_popover (leaf);
 
-            gtk_box_pack_start (GTK_BOX (hbox), leaf->label, TRUE, TRUE, 0);
+            gtk_box_pack_start (GTK_BOX (hbox), leaf->view->label, TRUE, TRUE, 0);
 
-            gtk_drag_source_set (leaf->outer, GDK_BUTTON1_MASK, drop_target, 1, GDK_ACTION_MOVE);
-            gtk_drag_source_set_icon_pixbuf (leaf->outer, leaf->paxui->icons[PX_ICON_SOURCE]);
+            gtk_drag_source_set (leaf->view->outer, GDK_BUTTON1_MASK, drop_target, 1, GDK_ACTION_MOVE);
+            gtk_drag_source_set_icon_pixbuf (leaf->view->outer, leaf->paxui->icons[PX_ICON_SOURCE]);
             break;
         case PAXUI_LEAF_TYPE_SINK:
             gtk_style_context_add_class (
-                    gtk_widget_get_style_context (leaf->outer), "sink");
+                    gtk_widget_get_style_context (leaf->view->outer), "sink");
 
-            gtk_box_pack_start (GTK_BOX (hbox), leaf->label, TRUE, TRUE, 0);
+            gtk_box_pack_start (GTK_BOX (hbox), leaf->view->label, TRUE, TRUE, 0);
 
             tool_button_add (leaf, hbox);
-            build_tool_popover (leaf);
 
-            gtk_drag_source_set (leaf->outer, GDK_BUTTON1_MASK, drop_target, 1, GDK_ACTION_MOVE);
-            gtk_drag_source_set_icon_pixbuf (leaf->outer, leaf->paxui->icons[PX_ICON_SINK]);
-            g_signal_connect (leaf->outer, "button-press-event", G_CALLBACK (paxui_actions_sink_button_event), leaf);
+            gtk_drag_source_set (leaf->view->outer, GDK_BUTTON1_MASK, drop_target, 1, GDK_ACTION_MOVE);
+            gtk_drag_source_set_icon_pixbuf (leaf->view->outer, leaf->paxui->icons[PX_ICON_SINK]);
+            g_signal_connect (leaf->view->outer, "button-press-event", G_CALLBACK (paxui_actions_sink_button_event), leaf);
             break;
         case PAXUI_LEAF_TYPE_SOURCE_OUTPUT:
             gtk_style_context_add_class (
-                    gtk_widget_get_style_context (leaf->outer), "source-output");
+                    gtk_widget_get_style_context (leaf->view->outer), "source-output");
 
-            gtk_box_pack_start (GTK_BOX (hbox), leaf->label, TRUE, TRUE, 0);
+            gtk_box_pack_start (GTK_BOX (hbox), leaf->view->label, TRUE, TRUE, 0);
 
             tool_button_add (leaf, hbox);
-            build_tool_popover (leaf);
 
-            gtk_drag_source_set (leaf->outer, GDK_BUTTON1_MASK, drop_target, 1, GDK_ACTION_MOVE);
-            gtk_drag_source_set_icon_pixbuf (leaf->outer, leaf->paxui->icons[PX_ICON_SOURCE]);
+            gtk_drag_source_set (leaf->view->outer, GDK_BUTTON1_MASK, drop_target, 1, GDK_ACTION_MOVE);
+            gtk_drag_source_set_icon_pixbuf (leaf->view->outer, leaf->paxui->icons[PX_ICON_SOURCE]);
             break;
         case PAXUI_LEAF_TYPE_SINK_INPUT:
             gtk_style_context_add_class (
-                    gtk_widget_get_style_context (leaf->outer), "sink-input");
+                    gtk_widget_get_style_context (leaf->view->outer), "sink-input");
 
             tool_button_add (leaf, hbox);
-            build_tool_popover (leaf);
 
-            gtk_box_pack_start (GTK_BOX (hbox), leaf->label, TRUE, TRUE, 0);
+            gtk_box_pack_start (GTK_BOX (hbox), leaf->view->label, TRUE, TRUE, 0);
 
-            gtk_drag_source_set (leaf->outer, GDK_BUTTON1_MASK, drop_target, 1, GDK_ACTION_MOVE);
-            gtk_drag_source_set_icon_pixbuf (leaf->outer, leaf->paxui->icons[PX_ICON_SINK]);
+            gtk_drag_source_set (leaf->view->outer, GDK_BUTTON1_MASK, drop_target, 1, GDK_ACTION_MOVE);
+            gtk_drag_source_set_icon_pixbuf (leaf->view->outer, leaf->paxui->icons[PX_ICON_SINK]);
             break;
     }
 
+    /* for reuse from pool */
+    g_object_set_data (G_OBJECT (leaf->view->outer), "label", leaf->view->label);
+    g_object_set_data (G_OBJECT (leaf->view->outer), "tool-button", leaf->view->tool_button);
+
     leaf_set_initial_pos (leaf);
 
-    gtk_widget_show_all (leaf->outer);
+    gtk_widget_show_all (leaf->view->outer);
 }
 
 
+/* push fields marked dirty by the info callbacks to the widgets */
 void
 leaf_gui_update (PaxuiLeaf *leaf)
 {
-    leaf_set_label (leaf);
-    leaf_set_volume (leaf);
-}
+    if (leaf->dirty == 0)
+    {
+        leaf->paxui->gui_skips++;
+        TRACE("gui update skipped, %u of %u", leaf->paxui->gui_skips,
+              leaf->paxui->gui_skips + leaf->paxui->gui_updates);
+        return;
+    }
+    leaf->paxui->gui_updates++;
 
+    if (leaf->dirty & PAXUI_DIRTY_NAME)   leaf_set_label (leaf);
+    if (leaf->dirty & PAXUI_DIRTY_MUTE)   leaf_set_mute (leaf);
+    if (leaf->dirty & PAXUI_DIRTY_VOLUME) leaf_set_volume (leaf);
 
-static gint
-cmp_so_y (gconstpointer a, gconstpointer b)
+    leaf->dirty = 0;
+}
+
+void
+leaf_gui_destroy (PaxuiLeaf *leaf)
 {
-    const PaxuiLeaf *so_a = a, *so_b = b;
-    PaxuiLeaf *bk_a, *bk_b;
-    Paxui *paxui = so_a->paxui;
-    gint d;
+    if (leaf->view == NULL) return;
 
-    bk_a = (so_a->client == G_MAXUINT32 ?
-                paxui_find_module_for_index (paxui, so_a->module) :
+    if (GTK_IS_WIDGET (leaf->view->outer))
+    {
+        if (leaf->view->att_y > 0)
+            grid_cell_set (leaf->paxui, leaf->x, leaf->view->att_y, FALSE);
+
+        if (!leaf_gui_pool_put (leaf))
+        {
+            tool_popover_free (leaf);
+            gtk_widget_destroy (leaf->view->outer);
+        }
+
+        edge_cache_invalidate (leaf->paxui);
+    }
+
+    g_slice_free (PaxuiView, leaf->view);
+    leaf->view = NULL;
+    paxui_leaf_update_owned (leaf);
+}
+
+
+static gint
+cmp_so_y (gconstpointer a, gconstpointer b)
+{
+    const PaxuiLeaf *so_a = a, *so_b = b;
+    PaxuiLeaf *bk_a, *bk_b;
+    Paxui *paxui = so_a->paxui;
+    gint d;
+
+    bk_a = (so_a->client == G_MAXUINT32 ?
+                paxui_find_module_for_index (paxui, so_a->module) :
                 paxui_find_client_for_index (paxui, so_a->client));
     if (bk_a == NULL) return 0;
     bk_b = (so_b->client == G_MAXUINT32 ?
@@ -1081,8 +1493,10 @@ cmp_so_y (gconstpointer a, gconstpointer b)
     if (bk_a == NULL) return 0;
     bk_b = paxui_find_source_for_index (paxui, so_b->source);
     if (bk_b == NULL) return 0;
+    if ((d = bk_a->y - bk_b->y)) return d;
 
-    return (bk_a->y - bk_b->y);
+    /* streams come from an unordered set, keep ties stable */
+    return (so_a->index > so_b->index) - (so_a->index < so_b->index);
 }
 
 static gint
@@ -1107,121 +1521,314 @@ cmp_si_y (gconstpointer a, gconstpointer b)
     if (bk_a == NULL) return 0;
     bk_b = paxui_find_sink_for_index (paxui, si_b->sink);
     if (bk_b == NULL) return 0;
+    if ((d = bk_a->y - bk_b->y)) return d;
 
-    return (bk_a->y - bk_b->y);
+    /* streams come from an unordered set, keep ties stable */
+    return (si_a->index > si_b->index) - (si_a->index < si_b->index);
+}
+
+/* list the block's streams of given type, sorted for placement */
+static GList *
+block_get_streams (PaxuiLeaf *block, guint leaf_type, GCompareFunc cmp_func, gint *n_streams)
+{
+    GHashTable *streams;
+    GHashTableIter iter;
+    PaxuiLeaf *st;
+    GList *t = NULL;
+    gint n = 0;
+
+    if ((streams = paxui_streams_for_leaf (block)))
+    {
+        g_hash_table_iter_init (&iter, streams);
+        while (g_hash_table_iter_next (&iter, (gpointer *) &st, NULL))
+        {
+            if (st->leaf_type != leaf_type) continue;
+
+            t = g_list_prepend (t, st);
+            n++;
+        }
+    }
+
+    *n_streams = n;
+
+    return g_list_sort (t, cmp_func);
 }
 
 static void
-paxui_gui_layout_siso (Paxui *paxui)
+block_detach_streams (PaxuiLeaf *block)
 {
-    GList *l;
-    gint y;
+    GHashTable *streams;
+    GHashTableIter iter;
+    PaxuiLeaf *st;
+
+    if ((streams = paxui_streams_for_leaf (block)) == NULL) return;
+
+    g_hash_table_iter_init (&iter, streams);
+    while (g_hash_table_iter_next (&iter, (gpointer *) &st, NULL))
+    {
+        if (st->view && gtk_widget_get_parent (st->view->outer))
+            leaf_grid_detach (st);
+    }
+}
+
+/* place the block's streams of given type in free rows around it */
+static void
+block_place_streams (PaxuiLeaf *block, guint leaf_type)
+{
+    Paxui *paxui = block->paxui;
+    GList *c, *t;
+    gint n, y, col;
+
+    if (leaf_type == PAXUI_LEAF_TYPE_SOURCE_OUTPUT)
+    {
+        col = PAXUI_COL_SRC_OPS;
+        t = block_get_streams (block, leaf_type, cmp_so_y, &n);
+    }
+    else
+    {
+        col = PAXUI_COL_SNK_IPS;
+        t = block_get_streams (block, leaf_type, cmp_si_y, &n);
+    }
+    if (n == 0) return;
+
+    y = MAX (1, block->y - (n - 1) / 2);
+    for (c = t; c; c = c->next)
+    {
+        PaxuiLeaf *st = c->data;
+
+        /* already placed this pass under its other owner */
+        if (st->view == NULL || gtk_widget_get_parent (st->view->outer)) continue;
+
+        y = grid_first_free (paxui, col, y);
+
+        st->y = y;
+        leaf_grid_reattach (st);
+    }
+
+    g_list_free (t);
+}
+
+static void
+layout_add_block (GHashTable *blocks, PaxuiLeaf *block)
+{
+    if (block && block->acam_link) g_hash_table_add (blocks, block);
+}
 
-    TRACE("layout siso");
+/* Collect gui blocks whose streams need placing since the last pass:
+ * touched blocks, plus owners of streams on touched sources/sinks */
+static GList *
+layout_get_touched_blocks (Paxui *paxui)
+{
+    GHashTable *blocks;
+    GHashTableIter iter;
+    gpointer key;
+    GList *list;
+    guint type;
 
-    paxui->acams = g_list_sort (paxui->acams, paxui_cmp_blocks_y);
+    blocks = g_hash_table_new (g_direct_hash, g_direct_equal);
 
-    /* place source_outputs */
-    g_list_foreach (paxui->source_outputs, (GFunc) leaf_grid_detach, NULL);
-    for (l = paxui->acams; l; l = l->next)
+    for (type = 0; type < PAXUI_LEAF_NUM_TYPES; type++)
     {
-        GList *c, *t;
-        gint n;
-        PaxuiLeaf *bl = l->data;
+        if (paxui->touched[type] == NULL) continue;
 
-        t = NULL;
-        n = 0;
-        for (c = paxui->source_outputs; c; c = c->next)
+        g_hash_table_iter_init (&iter, paxui->touched[type]);
+        while (g_hash_table_iter_next (&iter, &key, NULL))
         {
-            PaxuiLeaf *so = c->data;
+            PaxuiLeaf *leaf;
+            GHashTable *streams;
+            GHashTableIter s_iter;
+            PaxuiLeaf *st;
+
+            leaf = paxui_find_leaf_for_index (paxui, type, GPOINTER_TO_UINT (key));
+            if (leaf == NULL) continue;
 
-            if ((bl->leaf_type == PAXUI_LEAF_TYPE_CLIENT && so->client == bl->index) ||
-                (bl->leaf_type == PAXUI_LEAF_TYPE_MODULE && so->module == bl->index))
+            switch (type)
             {
-                t = g_list_append (t, so);
-                n++;
+                case PAXUI_LEAF_TYPE_CLIENT:
+                case PAXUI_LEAF_TYPE_MODULE:
+                    layout_add_block (blocks, leaf);
+                    break;
+                case PAXUI_LEAF_TYPE_SOURCE:
+                case PAXUI_LEAF_TYPE_SINK:
+                    if ((streams = paxui_streams_for_leaf (leaf)) == NULL) break;
+
+                    g_hash_table_iter_init (&s_iter, streams);
+                    while (g_hash_table_iter_next (&s_iter, (gpointer *) &st, NULL))
+                    {
+                        layout_add_block (blocks, paxui_find_client_for_index (paxui, st->client));
+                        layout_add_block (blocks, paxui_find_module_for_index (paxui, st->module));
+                    }
+                    break;
             }
         }
-        if (n == 0) continue;
 
-        t = g_list_sort (t, cmp_so_y);
-        y = MAX (1, bl->y - (n - 1) / 2);
-        for (c = t; c; c = c->next)
-        {
-            PaxuiLeaf *so = c->data;
+        g_hash_table_remove_all (paxui->touched[type]);
+    }
 
-            while (gtk_grid_get_child_at (GTK_GRID (paxui->grid), PAXUI_COL_SRC_OPS, y)) y++;
+    list = g_hash_table_get_keys (blocks);
+    g_hash_table_unref (blocks);
 
-            so->y = y;
-            leaf_grid_reattach (so);
-        }
+    return g_list_sort (list, paxui_cmp_blocks_y);
+}
 
-        g_list_free (t);
+static void
+layout_clear_touched (Paxui *paxui)
+{
+    guint type;
+
+    for (type = 0; type < PAXUI_LEAF_NUM_TYPES; type++)
+    {
+        if (paxui->touched[type]) g_hash_table_remove_all (paxui->touched[type]);
     }
+}
+
+static void
+paxui_gui_layout_siso (Paxui *paxui)
+{
+    GList *l, *blocks;
 
-    /* place sink_inputs */
-    g_list_foreach (paxui->sink_inputs, (GFunc) leaf_grid_detach, NULL);
-    for (l = paxui->acams; l; l = l->next)
+    if (paxui->layout_all)
     {
-        GList *c, *t;
-        gint n;
-        PaxuiLeaf *bl = l->data;
+        TRACE("layout siso: all");
 
-        t = NULL;
-        n = 0;
-        for (c = paxui->sink_inputs; c; c = c->next)
-        {
-            PaxuiLeaf *si = c->data;
+        paxui->layout_all = FALSE;
+        layout_clear_touched (paxui);
 
-            if ((bl->leaf_type == PAXUI_LEAF_TYPE_CLIENT && si->client == bl->index) ||
-                (bl->leaf_type == PAXUI_LEAF_TYPE_MODULE && si->module == bl->index))
-            {
-                t = g_list_append (t, si);
-                n++;
-            }
-        }
-        if (n == 0) continue;
+        paxui->acams = g_list_sort (paxui->acams, paxui_cmp_blocks_y);
 
-        t = g_list_sort (t, cmp_si_y);
-        y = MAX (1, bl->y - (n - 1) / 2);
-        for (c = t; c; c = c->next)
+        g_list_foreach (paxui->source_outputs, (GFunc) leaf_grid_detach, NULL);
+        g_list_foreach (paxui->sink_inputs, (GFunc) leaf_grid_detach, NULL);
+        for (l = paxui->acams; l; l = l->next)
         {
-            PaxuiLeaf *si = c->data;
+            block_place_streams (l->data, PAXUI_LEAF_TYPE_SOURCE_OUTPUT);
+            block_place_streams (l->data, PAXUI_LEAF_TYPE_SINK_INPUT);
+        }
 
-            while (gtk_grid_get_child_at (GTK_GRID (paxui->grid), PAXUI_COL_SNK_IPS, y)) y++;
+        return;
+    }
 
-            si->y = y;
-            leaf_grid_reattach (si);
-        }
+    /* only re-place streams hanging off blocks affected since last pass */
+    blocks = layout_get_touched_blocks (paxui);
+
+    TRACE("layout siso: %u blocks", g_list_length (blocks));
 
-        g_list_free (t);
+    g_list_foreach (blocks, (GFunc) block_detach_streams, NULL);
+    for (l = blocks; l; l = l->next)
+    {
+        block_place_streams (l->data, PAXUI_LEAF_TYPE_SOURCE_OUTPUT);
+        block_place_streams (l->data, PAXUI_LEAF_TYPE_SINK_INPUT);
     }
+
+    g_list_free (blocks);
 }
 
-static gboolean
-paxui_gui_layout_update (void *udata)
+static void
+layout_update_run (Paxui *paxui)
 {
-    Paxui *paxui = udata;
-
     TRACE("update layout");
 
     paxui_gui_layout_siso (paxui);
 
+    /* redraw only lines that moved */
+    edge_cache_invalidate (paxui);
+    edge_cache_refresh (paxui);
+
     paxui->updating = FALSE;
+}
 
-    gtk_widget_queue_draw (paxui->layout);
+static gboolean
+paxui_gui_layout_update (void *udata)
+{
+    Paxui *paxui = udata;
+
+    paxui->update_src = 0;
+    layout_update_run (paxui);
 
     return G_SOURCE_REMOVE;
 }
 
 
+static void
+layout_touch (Paxui *paxui, guint leaf_type, guint32 index)
+{
+    if (index == G_MAXUINT32) return;
+
+    if (paxui->touched[leaf_type] == NULL)
+        paxui->touched[leaf_type] = g_hash_table_new (g_direct_hash, g_direct_equal);
+
+    g_hash_table_add (paxui->touched[leaf_type], GUINT_TO_POINTER (index));
+}
+
+/* mark leaf as changed for the next layout pass & schedule the pass;
+ * for so/si the owning client & module are marked */
+void
+paxui_gui_touch_leaf (PaxuiLeaf *leaf)
+{
+    switch (leaf->leaf_type)
+    {
+        case PAXUI_LEAF_TYPE_SOURCE_OUTPUT:
+        case PAXUI_LEAF_TYPE_SINK_INPUT:
+            layout_touch (leaf->paxui, PAXUI_LEAF_TYPE_CLIENT, leaf->client);
+            layout_touch (leaf->paxui, PAXUI_LEAF_TYPE_MODULE, leaf->module);
+            break;
+        default:
+            layout_touch (leaf->paxui, leaf->leaf_type, leaf->index);
+            break;
+    }
+
+    edge_cache_invalidate (leaf->paxui);
+
+    paxui_gui_trigger_update (leaf->paxui);
+}
+
+
 void
 paxui_gui_trigger_update (Paxui *paxui)
 {
     if (paxui->updating) return;
     paxui->updating = TRUE;
 
-    g_timeout_add (100, paxui_gui_layout_update, paxui);
+    paxui->update_src = g_timeout_add (100, paxui_gui_layout_update, paxui);
+}
+
+/* lay out touched leaves now, for changes the user is waiting to see;
+ * takes the place of a pass already scheduled */
+void
+paxui_gui_update_now (Paxui *paxui)
+{
+    if (paxui->update_src)
+    {
+        g_source_remove (paxui->update_src);
+        paxui->update_src = 0;
+    }
+
+    layout_update_run (paxui);
+}
+
+
+static gboolean
+error_clear (gpointer udata)
+{
+    Paxui *paxui = udata;
+
+    gtk_header_bar_set_subtitle (GTK_HEADER_BAR (paxui->header), NULL);
+    paxui->error_src = 0;
+
+    return G_SOURCE_REMOVE;
+}
+
+/* show a failed request in the title bar for a while */
+void
+paxui_gui_show_error (Paxui *paxui, const gchar *msg)
+{
+    ERR("%s", msg);
+
+    if (paxui->header == NULL) return;
+
+    gtk_header_bar_set_subtitle (GTK_HEADER_BAR (paxui->header), msg);
+
+    if (paxui->error_src) g_source_remove (paxui->error_src);
+    paxui->error_src = g_timeout_add_seconds (PAXUI_ERROR_SECS, error_clear, paxui);
 }
 
 
@@ -1251,188 +1858,406 @@ layout_draw_drop_zone (cairo_t *cr, Paxui *paxui)
     }
 }
 
+/* block of a so/si: its client, or module if it has none */
+static PaxuiLeaf *
+stream_get_block (Paxui *paxui, PaxuiLeaf *st)
+{
+    if (st->client == G_MAXUINT32)
+        return paxui_find_module_for_index (paxui, st->module);
+
+    return paxui_find_client_for_index (paxui, st->client);
+}
+
 static void
-layout_draw_sink_inputs (cairo_t *cr, Paxui *paxui)
+edge_cache_add (Paxui *paxui, gint colour, GtkWidget *from, gboolean from_right,
+                                          GtkWidget *to, gboolean to_right)
 {
-    GList *l;
+    PaxuiEdge edge;
+    GdkRectangle alloc;
 
-    TRACE("draw si");
+    edge.colour = colour;
 
-    for (l = paxui->sink_inputs; l; l = l->next)
+    gtk_widget_get_allocation (from, &alloc);
+    edge.x1 = from_right ? alloc.x + alloc.width - PAXUI_LINE_WIDTH : alloc.x + PAXUI_LINE_WIDTH;
+    edge.y1 = alloc.y + alloc.height / 2;
+
+    gtk_widget_get_allocation (to, &alloc);
+    edge.x2 = to_right ? alloc.x + alloc.width - PAXUI_LINE_WIDTH : alloc.x + PAXUI_LINE_WIDTH;
+    edge.y2 = alloc.y + alloc.height / 2;
+
+    g_array_append_val (paxui->edges, edge);
+}
+
+static gint
+edge_cmp_colour (gconstpointer a, gconstpointer b)
+{
+    return ((const PaxuiEdge *) a)->colour - ((const PaxuiEdge *) b)->colour;
+}
+
+/* range of bands an edge's stroke crosses */
+static void
+edge_rows_span (const PaxuiEdge *edge, gint *first, gint *last)
+{
+    gdouble top, bottom;
+
+    top    = MIN (edge->y1, edge->y2) - PAXUI_LINE_WIDTH / 2;
+    bottom = MAX (edge->y1, edge->y2) + PAXUI_LINE_WIDTH / 2;
+
+    *first = MAX (0, (gint) top / PAXUI_EDGE_ROW);
+    *last  = MAX (0, (gint) bottom / PAXUI_EDGE_ROW);
+}
+
+/* index edges by the bands they cross; edges of band b are
+ * edge_rows[edge_row_start[b] .. edge_row_start[b+1]] */
+static void
+edge_rows_rebuild (Paxui *paxui)
+{
+    guint i, n_rows = 0;
+    guint *start, *fill;
+    gint b, first, last;
+
+    if (paxui->edge_row_start == NULL)
     {
-        PaxuiLeaf *si = l->data;
-        PaxuiLeaf *sk = NULL;
-        PaxuiLeaf *bk = NULL;
-        PaxuiColour colour;
-        gint si_x, si_y;
-        GdkRectangle si_alloc;
+        paxui->edge_row_start = g_array_new (FALSE, FALSE, sizeof (guint));
+        paxui->edge_rows = g_array_new (FALSE, FALSE, sizeof (guint));
+    }
 
-        if (si->y < 1 || si->outer == NULL) continue;
+    for (i = 0; i < paxui->edges->len; i++)
+    {
+        edge_rows_span (&g_array_index (paxui->edges, PaxuiEdge, i), &first, &last);
+        n_rows = MAX (n_rows, (guint) last + 1);
+    }
 
-        if (si->client == G_MAXUINT32)
-        {
-            PaxuiLeaf *md;
+    g_array_set_size (paxui->edge_row_start, n_rows + 1);
+    start = (guint *) paxui->edge_row_start->data;
+    memset (start, 0, (n_rows + 1) * sizeof (guint));
 
-            md = paxui_find_module_for_index (paxui, si->module);
-            if (md) bk = md;
-        }
-        else
-        {
-            PaxuiLeaf *cl;
+    /* count per band, then offsets */
+    for (i = 0; i < paxui->edges->len; i++)
+    {
+        edge_rows_span (&g_array_index (paxui->edges, PaxuiEdge, i), &first, &last);
+        for (b = first; b <= last; b++) start[b + 1]++;
+    }
+    for (b = 1; b <= (gint) n_rows; b++) start[b] += start[b - 1];
 
-            cl = paxui_find_client_for_index (paxui, si->client);
-            if (cl) bk = cl;
-        }
-        if (bk == NULL) continue;
+    g_array_set_size (paxui->edge_rows, start[n_rows]);
+    if (n_rows == 0) return;
 
-        if (si->colour < 0)
-            si->colour = get_new_colour (paxui);
+    fill = g_new (guint, n_rows);
+    memcpy (fill, start, n_rows * sizeof (guint));
 
-        colour = paxui->colours[si->colour];
+    for (i = 0; i < paxui->edges->len; i++)
+    {
+        edge_rows_span (&g_array_index (paxui->edges, PaxuiEdge, i), &first, &last);
+        for (b = first; b <= last; b++)
+            g_array_index (paxui->edge_rows, guint, fill[b]++) = i;
+    }
 
-        cairo_set_source_rgba (cr, CR_RBGA (colour));
+    g_free (fill);
+}
 
-        if (bk->outer && bk->y > 0)
-        {
-            gint bk_x, bk_y;
-            GdkRectangle bk_alloc;
+static guint
+edge_hash (gconstpointer key)
+{
+    const PaxuiEdge *edge = key;
+    guint hash = edge->colour;
 
-            gtk_widget_get_allocation (bk->outer, &bk_alloc);
-            bk_x = bk_alloc.x + bk_alloc.width - PAXUI_LINE_WIDTH;
-            bk_y = bk_alloc.y + bk_alloc.height / 2;
+    hash = hash * 31 + (gint) edge->x1;
+    hash = hash * 31 + (gint) edge->y1;
+    hash = hash * 31 + (gint) edge->x2;
+    hash = hash * 31 + (gint) edge->y2;
 
-            gtk_widget_get_allocation (si->outer, &si_alloc);
-            si_x = si_alloc.x + PAXUI_LINE_WIDTH;
-            si_y = si_alloc.y + si_alloc.height / 2;
+    return hash;
+}
 
-            cairo_move_to (cr, bk_x, bk_y);
-            cairo_line_to (cr, si_x, si_y);
-            cairo_stroke (cr);
-        }
+static gboolean
+edge_equal (gconstpointer a, gconstpointer b)
+{
+    const PaxuiEdge *ea = a, *eb = b;
 
-        sk = paxui_find_sink_for_index (paxui, si->sink);
-        if (sk && sk->y && sk->outer)
-        {
-            gint sk_x, sk_y;
-            GdkRectangle sk_alloc;
+    return ea->colour == eb->colour &&
+           ea->x1 == eb->x1 && ea->y1 == eb->y1 &&
+           ea->x2 == eb->x2 && ea->y2 == eb->y2;
+}
 
-            gtk_widget_get_allocation (si->outer, &si_alloc);
-            si_x = si_alloc.x + si_alloc.width - PAXUI_LINE_WIDTH;
-            si_y = si_alloc.y + si_alloc.height / 2;
+static void
+edge_damage (Paxui *paxui, const PaxuiEdge *edge)
+{
+    GdkRectangle rect;
 
-            gtk_widget_get_allocation (sk->outer, &sk_alloc);
-            sk_x = sk_alloc.x + PAXUI_LINE_WIDTH;
-            sk_y = sk_alloc.y + sk_alloc.height / 2;
+    rect.x = MIN (edge->x1, edge->x2) - PAXUI_LINE_WIDTH;
+    rect.y = MIN (edge->y1, edge->y2) - PAXUI_LINE_WIDTH;
+    rect.width  = ABS (edge->x2 - edge->x1) + 2 * PAXUI_LINE_WIDTH;
+    rect.height = ABS (edge->y2 - edge->y1) + 2 * PAXUI_LINE_WIDTH;
 
-            cairo_move_to (cr, si_x, si_y);
-            cairo_line_to (cr, sk_x, sk_y);
-            cairo_stroke (cr);
-        }
-    }
+    layout_damage_rect (paxui, &rect, TRUE);
+}
+
+static gint
+cmp_uint (gconstpointer a, gconstpointer b)
+{
+    guint ua = *(const guint *) a;
+    guint ub = *(const guint *) b;
+
+    return (ua > ub) - (ua < ub);
 }
 
+/* collect end points of all so/si lines, grouped by colour */
 static void
-layout_draw_source_outputs (cairo_t *cr, Paxui *paxui)
+edge_cache_rebuild (Paxui *paxui)
 {
     GList *l;
 
-    TRACE ("draw so");
+    TRACE("rebuild edges");
+
+    if (paxui->edges == NULL)
+        paxui->edges = g_array_new (FALSE, FALSE, sizeof (PaxuiEdge));
+    g_array_set_size (paxui->edges, 0);
+
+    for (l = paxui->sink_inputs; l; l = l->next)
+    {
+        PaxuiLeaf *si = l->data;
+        PaxuiLeaf *sk, *bk;
+
+        if (si->y < 1 || si->view == NULL) continue;
+        if ((bk = stream_get_block (paxui, si)) == NULL) continue;
+
+        if (si->colour < 0)
+            si->colour = get_new_colour (paxui);
+
+        if (bk->view && bk->y > 0)
+            edge_cache_add (paxui, si->colour, bk->view->outer, TRUE, si->view->outer, FALSE);
+
+        sk = paxui_find_sink_for_index (paxui, si->sink);
+        if (sk && sk->y && sk->view)
+            edge_cache_add (paxui, si->colour, si->view->outer, TRUE, sk->view->outer, FALSE);
+    }
 
     for (l = paxui->source_outputs; l; l = l->next)
     {
         PaxuiLeaf *so = l->data;
-        PaxuiLeaf *sc = NULL;
-        PaxuiLeaf *bk = NULL;
-        PaxuiColour colour;
-        gint so_x, so_y;
-        GdkRectangle so_alloc;
+        PaxuiLeaf *sc, *bk;
+
+        if (so->y < 1 || so->view == NULL) continue;
+        if ((bk = stream_get_block (paxui, so)) == NULL) continue;
+
+        if (so->colour < 0)
+            so->colour = get_new_colour (paxui);
+
+        if (bk->view && bk->y > 0)
+            edge_cache_add (paxui, so->colour, so->view->outer, TRUE, bk->view->outer, FALSE);
+
+        sc = paxui_find_source_for_index (paxui, so->source);
+        if (sc && sc->y && sc->view)
+            edge_cache_add (paxui, so->colour, sc->view->outer, TRUE, so->view->outer, FALSE);
+    }
+
+    g_array_sort (paxui->edges, edge_cmp_colour);
+    edge_rows_rebuild (paxui);
+
+    paxui->edges_valid = TRUE;
+}
+
+/* rebuild a stale edge cache & damage lines that were added, removed or moved */
+static void
+edge_cache_refresh (Paxui *paxui)
+{
+    GArray *old;
+    GHashTable *unmatched;
+    GHashTableIter iter;
+    PaxuiEdge *edge;
+    guint i;
+
+    if (paxui->edges_valid) return;
+
+    old = paxui->edges;
+    paxui->edges = NULL;
+    edge_cache_rebuild (paxui);
+
+    if (old == NULL) return;
 
-        if (so->y < 1 || so->outer == NULL) continue;
+    unmatched = g_hash_table_new (edge_hash, edge_equal);
+    for (i = 0; i < old->len; i++)
+        g_hash_table_add (unmatched, &g_array_index (old, PaxuiEdge, i));
 
-        if (so->client == G_MAXUINT32)
+    for (i = 0; i < paxui->edges->len; i++)
+    {
+        edge = &g_array_index (paxui->edges, PaxuiEdge, i);
+        if (!g_hash_table_remove (unmatched, edge)) edge_damage (paxui, edge);
+    }
+
+    g_hash_table_iter_init (&iter, unmatched);
+    while (g_hash_table_iter_next (&iter, (gpointer *) &edge, NULL))
+        edge_damage (paxui, edge);
+
+    g_hash_table_destroy (unmatched);
+    g_array_free (old, TRUE);
+}
+
+/* stroke cached edges crossing the clip area, one path per colour */
+static void
+layout_draw_edges (cairo_t *cr, Paxui *paxui)
+{
+    GArray *visible;
+    guint i, k, n_rows;
+    guint *start;
+    gint b, first, last, e_first, e_last;
+    gint colour = -1;
+    gdouble cx1, cy1, cx2, cy2;
+
+    edge_cache_refresh (paxui);
+
+    n_rows = paxui->edge_row_start->len - 1;
+    if (n_rows == 0) return;
+
+    cairo_clip_extents (cr, &cx1, &cy1, &cx2, &cy2);
+
+    first = MAX (0, (gint) cy1 / PAXUI_EDGE_ROW);
+    last  = MIN ((gint) n_rows - 1, (gint) cy2 / PAXUI_EDGE_ROW);
+    start = (guint *) paxui->edge_row_start->data;
+
+    visible = g_array_new (FALSE, FALSE, sizeof (guint));
+
+    for (b = first; b <= last; b++)
+    {
+        for (k = start[b]; k < start[b + 1]; k++)
         {
-            PaxuiLeaf *md;
+            PaxuiEdge *edge;
 
-            md = paxui_find_module_for_index (paxui, so->module);
-            if (md) bk = md;
+            i = g_array_index (paxui->edge_rows, guint, k);
+            edge = &g_array_index (paxui->edges, PaxuiEdge, i);
+
+            /* take each edge once, from its first visible band */
+            edge_rows_span (edge, &e_first, &e_last);
+            if (MAX (e_first, first) != b) continue;
+
+            if (MAX (edge->x1, edge->x2) + PAXUI_LINE_WIDTH < cx1 ||
+                MIN (edge->x1, edge->x2) - PAXUI_LINE_WIDTH > cx2) continue;
+
+            g_array_append_val (visible, i);
         }
-        else
+    }
+
+    /* edges are sorted by colour, so index order groups colours */
+    g_array_sort (visible, cmp_uint);
+
+    TRACE("draw %u of %u edges", visible->len, paxui->edges->len);
+
+    for (k = 0; k < visible->len; k++)
+    {
+        PaxuiEdge *edge = &g_array_index (paxui->edges, PaxuiEdge, g_array_index (visible, guint, k));
+
+        if (edge->colour != colour)
         {
-            PaxuiLeaf *cl;
+            if (colour >= 0) cairo_stroke (cr);
 
-            cl = paxui_find_client_for_index (paxui, so->client);
-            if (cl) bk = cl;
+            colour = edge->colour;
+            cairo_set_source_rgba (cr, CR_RBGA (paxui->colours[colour]));
         }
-        if (bk == NULL) continue;
 
-        if (so->colour < 0)
-            so->colour = get_new_colour (paxui);
+        cairo_move_to (cr, edge->x1, edge->y1);
+        cairo_line_to (cr, edge->x2, edge->y2);
+    }
 
-        colour = paxui->colours[so->colour];
+    if (colour >= 0) cairo_stroke (cr);
 
-        cairo_set_source_rgba (cr, CR_RBGA (colour));
+    g_array_free (visible, TRUE);
+}
 
-        if (bk->outer && bk->y > 0)
-        {
-            gint bk_x, bk_y;
-            GdkRectangle bk_alloc;
+/* render so/si lines for the visible area into an offscreen layer;
+ * fully redone when scroll position or size change, otherwise only
+ * the damaged areas are */
+static void
+edge_layer_update (Paxui *paxui, gdouble x, gdouble y, gint w, gint h)
+{
+    cairo_t *lcr;
+    gboolean full;
+    gint i;
 
-            gtk_widget_get_allocation (so->outer, &so_alloc);
-            so_x = so_alloc.x + so_alloc.width - PAXUI_LINE_WIDTH;
-            so_y = so_alloc.y + so_alloc.height / 2;
+    edge_cache_refresh (paxui);
 
-            gtk_widget_get_allocation (bk->outer, &bk_alloc);
-            bk_x = bk_alloc.x + PAXUI_LINE_WIDTH;
-            bk_y = bk_alloc.y + bk_alloc.height / 2;
+    full = !(paxui->edge_layer &&
+             paxui->edge_layer_x == x && paxui->edge_layer_y == y &&
+             paxui->edge_layer_w == w && paxui->edge_layer_h == h);
 
-            cairo_move_to (cr, so_x, so_y);
-            cairo_line_to (cr, bk_x, bk_y);
-            cairo_stroke (cr);
-        }
+    if (!full && (paxui->edge_damage == NULL || cairo_region_is_empty (paxui->edge_damage)))
+        return;
 
-        sc = paxui_find_source_for_index (paxui, so->source);
-        if (sc && sc->y && sc->outer)
-        {
-            gint sc_x, sc_y;
-            GdkRectangle sc_alloc;
+    if (paxui->edge_layer == NULL || paxui->edge_layer_w != w || paxui->edge_layer_h != h)
+    {
+        if (paxui->edge_layer) cairo_surface_destroy (paxui->edge_layer);
+
+        paxui->edge_layer = gdk_window_create_similar_surface (
+                gtk_widget_get_window (paxui->layout), CAIRO_CONTENT_COLOR_ALPHA, w, h);
+        paxui->edge_layer_w = w;
+        paxui->edge_layer_h = h;
+    }
 
-            gtk_widget_get_allocation (sc->outer, &sc_alloc);
-            sc_x = sc_alloc.x + sc_alloc.width - PAXUI_LINE_WIDTH;
-            sc_y = sc_alloc.y + sc_alloc.height / 2;
+    TRACE("render edge layer: %s", full ? "full" : "damage");
 
-            gtk_widget_get_allocation (so->outer, &so_alloc);
-            so_x = so_alloc.x + + PAXUI_LINE_WIDTH;
-            so_y = so_alloc.y + so_alloc.height / 2;
+    lcr = cairo_create (paxui->edge_layer);
+    cairo_translate (lcr, -x, -y);
+
+    if (!full)
+    {
+        for (i = 0; i < cairo_region_num_rectangles (paxui->edge_damage); i++)
+        {
+            cairo_rectangle_int_t rect;
 
-            cairo_move_to (cr, sc_x, sc_y);
-            cairo_line_to (cr, so_x, so_y);
-            cairo_stroke (cr);
+            cairo_region_get_rectangle (paxui->edge_damage, i, &rect);
+            cairo_rectangle (lcr, rect.x, rect.y, rect.width, rect.height);
         }
+        cairo_clip (lcr);
     }
+
+    cairo_set_operator (lcr, CAIRO_OPERATOR_CLEAR);
+    cairo_paint (lcr);
+    cairo_set_operator (lcr, CAIRO_OPERATOR_OVER);
+
+    cairo_set_line_width (lcr, PAXUI_LINE_WIDTH);
+    layout_draw_edges (lcr, paxui);
+
+    cairo_destroy (lcr);
+
+    if (paxui->edge_damage)
+    {
+        cairo_region_destroy (paxui->edge_damage);
+        paxui->edge_damage = NULL;
+    }
+
+    paxui->edge_layer_x = x;
+    paxui->edge_layer_y = y;
 }
 
 static gboolean
 layout_draw (GtkWidget *layout, cairo_t *cr, Paxui *paxui)
 {
     GtkAdjustment *h, *v;
+    gdouble x, y;
 
     TRACE("draw cb");
 
     h = gtk_scrollable_get_hadjustment (GTK_SCROLLABLE (paxui->layout));
     v = gtk_scrollable_get_vadjustment (GTK_SCROLLABLE (paxui->layout));
-    cairo_translate (cr, -gtk_adjustment_get_value (h), -gtk_adjustment_get_value (v));
+    x = gtk_adjustment_get_value (h);
+    y = gtk_adjustment_get_value (v);
+
+    edge_layer_update (paxui, x, y,
+                       gtk_widget_get_allocated_width (layout),
+                       gtk_widget_get_allocated_height (layout));
 
+    cairo_set_source_surface (cr, paxui->edge_layer, 0, 0);
+    cairo_paint (cr);
+
+    /* transient highlights go over the cached layer */
+    cairo_translate (cr, -x, -y);
     cairo_set_line_width (cr, PAXUI_LINE_WIDTH);
 
     layout_draw_drop_zone (cr, paxui);
 
-    layout_draw_sink_inputs (cr, paxui);
-    layout_draw_source_outputs (cr, paxui);
-
     return FALSE;
 }
 
-
 static void
 grid_alloc (GtkWidget *grid, GdkRectangle *alloc, gpointer udata)
 {
@@ -1444,20 +2269,108 @@ grid_alloc (GtkWidget *grid, GdkRectangle *alloc, gpointer udata)
                          alloc->width  + 2*PAXUI_SPACE,
                          alloc->height + 2*PAXUI_SPACE);
 
-    if (paxui->pa_init_done)
+    edge_cache_invalidate (paxui);
+    edge_cache_refresh (paxui);
+}
+
+
+static void
+populate_blocks (Paxui *paxui, GList *blocks)
+{
+    GList *l;
+
+    for (l = blocks; l; l = l->next)
+    {
+        PaxuiLeaf *block = l->data;
+
+        paxui_block_update_active (block, paxui);
+        /* skip lazy placeholders whose info never came */
+        if (block->active && block->name) leaf_gui_new (block);
+    }
+}
+
+static void
+populate_unplaced (GList *column)
+{
+    GList *l;
+
+    for (l = column; l; l = l->next)
+    {
+        PaxuiLeaf *leaf = l->data;
+
+        if (leaf->view && gtk_widget_get_parent (leaf->view->outer) == NULL)
+            leaf_attach_free_row (leaf);
+    }
+}
+
+static void
+populate_size_group (Paxui *paxui, GList *column)
+{
+    GList *l;
+
+    for (l = column; l; l = l->next)
     {
-        paxui->pa_init_done = FALSE;
+        PaxuiLeaf *leaf = l->data;
 
-        g_idle_add (position_to_init_full, paxui);
+        if (leaf->view)
+            gtk_size_group_add_widget (GTK_SIZE_GROUP (paxui->size_group), leaf->view->outer);
     }
 }
 
+/* build widgets for everything fetched in the initial load in one batch,
+ * then position them from the saved state in a single pass */
+void
+paxui_gui_populate (Paxui *paxui)
+{
+    DBG("populate gui");
+
+    paxui_gui_rm_spinner (paxui);
+
+    paxui->populating = TRUE;
+    gtk_widget_hide (paxui->grid);
+    gtk_widget_freeze_child_notify (paxui->grid);
+
+    populate_blocks (paxui, paxui->modules);
+    populate_blocks (paxui, paxui->clients);
+    g_list_foreach (paxui->sources, (GFunc) leaf_gui_new, NULL);
+    g_list_foreach (paxui->sinks, (GFunc) leaf_gui_new, NULL);
+    g_list_foreach (paxui->source_outputs, (GFunc) leaf_gui_new, NULL);
+    g_list_foreach (paxui->sink_inputs, (GFunc) leaf_gui_new, NULL);
+
+    position_to_init_column (paxui, paxui->sources, paxui->src_inits);
+    position_to_init_column (paxui, paxui->acams, paxui->cam_inits);
+    position_to_init_column (paxui, paxui->sinks, paxui->snk_inits);
+
+    paxui_unload_init_strings (paxui);
+
+    paxui->layout_all = TRUE;
+    paxui_gui_layout_siso (paxui);
+
+    /* streams without a block still need a row */
+    populate_unplaced (paxui->source_outputs);
+    populate_unplaced (paxui->sink_inputs);
+
+    /* join the size group once everything is in place */
+    populate_size_group (paxui, paxui->sources);
+    populate_size_group (paxui, paxui->acams);
+    populate_size_group (paxui, paxui->sinks);
+    populate_size_group (paxui, paxui->source_outputs);
+    populate_size_group (paxui, paxui->sink_inputs);
+
+    gtk_widget_thaw_child_notify (paxui->grid);
+    gtk_widget_show (paxui->grid);
+    paxui->populating = FALSE;
+
+    gtk_widget_queue_draw (paxui->layout);
+}
+
 
 void
 paxui_gui_add_spinner (Paxui *paxui)
 {
     paxui->spinner = gtk_spinner_new ();
     gtk_grid_attach (GTK_GRID (paxui->grid), paxui->spinner, PAXUI_COL_BLOCKS, 1, 1, 1);
+    grid_cell_set (paxui, PAXUI_COL_BLOCKS, 1, TRUE);
 
     gtk_widget_show (paxui->spinner);
     gtk_spinner_start (GTK_SPINNER (paxui->spinner));
@@ -1470,6 +2383,7 @@ paxui_gui_rm_spinner (Paxui *paxui)
 
     gtk_widget_destroy (paxui->spinner);
     paxui->spinner = NULL;
+    grid_cell_set (paxui, PAXUI_COL_BLOCKS, 1, FALSE);
 }
 
 
@@ -1541,6 +2455,7 @@ add_grid_head_item (Paxui *paxui, const gchar *title, GdkPixbuf *pb, gint column
     vbox = gtk_box_new (GTK_ORIENTATION_VERTICAL, 4);
     gtk_widget_set_valign (vbox, GTK_ALIGN_END);
     gtk_grid_attach (GTK_GRID (paxui->grid), vbox, column, 0, 1, 1);
+    grid_cell_set (paxui, column, 0, TRUE);
     gtk_size_group_add_widget (GTK_SIZE_GROUP (paxui->size_group), vbox);
 
     if (pb)
@@ -1567,7 +2482,7 @@ paxui_gui_build_gui (Paxui *paxui)
     g_signal_connect (paxui->window, "focus-in-event",  G_CALLBACK (window_focusin_cb),  paxui);
     g_signal_connect (paxui->window, "focus-out-event", G_CALLBACK (window_focusout_cb), paxui);
 
-    head = gtk_header_bar_new ();
+    head = paxui->header = gtk_header_bar_new ();
     gtk_window_set_titlebar (GTK_WINDOW (paxui->window), head);
     gtk_header_bar_set_has_subtitle (GTK_HEADER_BAR (head), FALSE);
     gtk_header_bar_set_title (GTK_HEADER_BAR (head), "Paxui");
@@ -1620,7 +2535,8 @@ paxui_gui_build_gui (Paxui *paxui)
     g_signal_connect (paxui->window, "button-press-event", G_CALLBACK (paxui_actions_window_button_event), paxui);
     g_signal_connect (paxui->window, "delete-event", G_CALLBACK (window_delete_event), paxui);
 
-    paxui_gui_layout_update (paxui);
+    paxui->layout_all = TRUE;
+    paxui_gui_update_now (paxui);
 }
 
 
@@ -4,12 +4,18 @@
 
 void        paxui_gui_activate              (GApplication *app, Paxui *paxui);
 void        paxui_gui_trigger_update        (Paxui *paxui);
+void        paxui_gui_touch_leaf            (PaxuiLeaf *leaf);
+void        paxui_gui_update_now            (Paxui *paxui);
+void        paxui_gui_show_error            (Paxui *paxui, const gchar *msg);
 
 void        paxui_gui_add_spinner           (Paxui *paxui);
 void        paxui_gui_rm_spinner            (Paxui *paxui);
+void        paxui_gui_populate              (Paxui *paxui);
+void        paxui_gui_free_pools            (Paxui *paxui);
 
 void        leaf_gui_new                    (PaxuiLeaf *leaf);
 void        leaf_gui_update                 (PaxuiLeaf *leaf);
+void        leaf_gui_destroy                (PaxuiLeaf *leaf);
 
 void        paxui_gui_colour_free           (Paxui *paxui, gint index);
 void        paxui_gui_get_default_colours   (Paxui *paxui);
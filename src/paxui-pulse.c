@@ -8,54 +8,9 @@
 
 
 #define PAXUI_CLIENT_NAME "Paxui"
+#define PAXUI_OP_BUCKET0 (250)      /* usecs, upper bound of first latency bucket */
 
 
-/* First strips whitespace from the ends of long_name.
- * Then, if long_name contains more than n words, return n words
- * with the addition of ellipsis character in utf-8;
- * otherwise returns a copy of stripped long_name */
-static gchar *
-make_short_name (gchar *long_name, gint n)
-{
-    gchar *short_name, *p, *s;
-    gboolean in_word;
-
-    if (long_name == NULL || n < 1) return NULL;
-
-    g_strstrip (long_name);
-
-    for (p = long_name, s = p, in_word = TRUE; *p; p++)
-    {
-        if (g_ascii_isspace (*p))
-        {
-            if (in_word)
-            {
-                s = p;
-                n--;
-                if (n == 0) break;
-                in_word = FALSE;
-            }
-        }
-        else
-        {
-            in_word = TRUE;
-        }
-    }
-    if (*p == '\0')
-    {
-        short_name = g_malloc (p - long_name + 1);
-        strcpy (short_name, long_name);
-    }
-    else
-    {
-        short_name = g_malloc (s - long_name + 4);
-        strncpy (short_name, long_name, s - long_name);
-        strcpy (short_name + (s - long_name), PAXUI_UTF8_ELLIPSIS);
-    }
-
-    return short_name;
-}
-
 static gchar *
 make_owner_module_name (const gchar *name, guint index)
 {
@@ -64,66 +19,53 @@ make_owner_module_name (const gchar *name, guint index)
                 index);
 }
 
-static gchar *
-make_utf8_name (const gchar *name)
+static void
+leaf_set_owner_module_name (PaxuiLeaf *leaf, PaxuiLeaf *module)
 {
-    static const gchar *charset = NULL;
-    static gboolean is_utf8;
-    gchar *utf8;
-
-    if (charset == NULL)
-    {
-        is_utf8 = g_get_charset (&charset);
-
-        DBG("encoding is '%s'", charset);
-    }
-
-    if (is_utf8)
-    {
+    gchar *owner;
 
-        return g_utf8_make_valid (name, -1);
-    }
-
-    utf8 = g_locale_to_utf8 (name, -1, NULL, NULL, NULL);
-
-    return (utf8 ? utf8 : g_utf8_make_valid (name, -1));
+    owner = make_owner_module_name (module->utf8_name, module->index);
+    paxui_leaf_set_short_name (leaf, owner);
+    g_free (owner);
 }
 
 static void
 leaf_get_strings (PaxuiLeaf *leaf, const gchar *name)
 {
-    g_free (leaf->name);
-    g_free (leaf->short_name);
-    g_free (leaf->utf8_name);
+    if (leaf->name && g_strcmp0 (leaf->name, name) == 0)
+    {
+        leaf->paxui->name_skips++;
+        return;
+    }
+
+    leaf->dirty |= PAXUI_DIRTY_NAME;
 
-    leaf->name = g_strdup (name);
+    paxui_leaf_set_name (leaf, name);
 
     switch (leaf->leaf_type)
     {
         PaxuiLeaf *md;
 
         case PAXUI_LEAF_TYPE_CLIENT:
-            leaf->utf8_name = make_utf8_name (name);
-            leaf->short_name = make_short_name (leaf->utf8_name, 3);
+            paxui_leaf_set_short_name (leaf, NULL);
             break;
 
         case PAXUI_LEAF_TYPE_SOURCE_OUTPUT:
         case PAXUI_LEAF_TYPE_SINK_INPUT:
-            leaf->utf8_name = make_utf8_name (name);
+            /* a lazy placeholder module is named when its info arrives */
             if (leaf->client == G_MAXUINT32 &&
-                (md = paxui_find_module_for_index (leaf->paxui, leaf->module)))
+                (md = paxui_find_module_for_index (leaf->paxui, leaf->module)) &&
+                md->name)
             {
-                leaf->short_name = make_owner_module_name (md->utf8_name, md->index);
+                leaf_set_owner_module_name (leaf, md);
             }
             else
             {
-                leaf->short_name = make_short_name (leaf->utf8_name, 3);
+                paxui_leaf_set_short_name (leaf, NULL);
             }
             break;
 
         default:
-            leaf->utf8_name = g_utf8_make_valid (name, -1);
-            leaf->short_name = NULL;
             break;
     }
 }
@@ -275,187 +217,895 @@ event_fac_str (pa_subscription_event_type_t facility)
     }
 }
 
+/* With ThreadedMainloop set, libpulse runs on its own thread. Its
+ * callbacks copy what they need from each reply into a delta & push it
+ * onto a lock-free stack; the gtk thread takes the whole stack at once
+ * and replays the deltas in order through the same callbacks, passing
+ * a NULL context. pa calls from the gtk thread take the mainloop lock. */
 
-static PaxuiLeaf *
-paxui_find_source_output_for_module (const Paxui *paxui, guint32 index)
+enum
 {
-    GList *l;
-    PaxuiLeaf *so;
+    PAXUI_DELTA_CLIENT,
+    PAXUI_DELTA_MODULE,
+    PAXUI_DELTA_SOURCE,
+    PAXUI_DELTA_SINK,
+    PAXUI_DELTA_SOURCE_OUTPUT,
+    PAXUI_DELTA_SINK_INPUT,
+    PAXUI_DELTA_EVENT,
+    PAXUI_DELTA_SUBSCRIBED,
+    PAXUI_DELTA_CONTEXT_STATE,
+    PAXUI_DELTA_REQUEST_DONE,
+    PAXUI_DELTA_VOLUME_DONE,
+    PAXUI_DELTA_MUTE_DONE,
+    PAXUI_DELTA_MOVE_DONE
+};
+
+typedef struct _PaxuiDelta
+{
+    struct _PaxuiDelta *next;
+    pa_context     *ctx;        /* replies for an old context are dropped */
+    guint           kind;
+    gint            eol;        /* list end; success or state for notifications */
+
+    guint32         index;
+    guint32         owner_module;
+    guint32         client;
+    guint32         device;     /* stream's sink or source, device's monitor */
+    guint           event;      /* event type, or facility of request */
+    gchar          *name;
+    gchar          *text;       /* description or argument */
+
+    gboolean        has_volume;
+    gboolean        volume_writable;
+    gint            mute;
+    pa_cvolume      volume;
+    pa_channel_map  channel_map;
+
+    guint           seq;        /* request, volume or mute send for *_DONE */
+    gpointer        data;       /* move request for MOVE_DONE */
+} PaxuiDelta;
+
+typedef struct _PaxuiMoveRequest
+{
+    Paxui          *paxui;
+    guint           leaf_type;
+    guint32         index;
+    guint32         from, to;   /* device indices */
+} PaxuiMoveRequest;
+
+
+static void
+pulse_lock (Paxui *paxui)
+{
+    if (paxui->pa_tml) pa_threaded_mainloop_lock (paxui->pa_tml);
+}
 
-    for (l = paxui->source_outputs; l; l = l->next)
+static void
+pulse_unlock (Paxui *paxui)
+{
+    if (paxui->pa_tml) pa_threaded_mainloop_unlock (paxui->pa_tml);
+}
+
+static PaxuiDelta *
+delta_new (pa_context *c, guint kind, gint eol)
+{
+    PaxuiDelta *d;
+
+    d = g_slice_new0 (PaxuiDelta);
+    d->ctx = c;
+    d->kind = kind;
+    d->eol = eol;
+
+    return d;
+}
+
+static void
+delta_free (PaxuiDelta *d)
+{
+    g_free (d->name);
+    g_free (d->text);
+    if (d->kind == PAXUI_DELTA_MOVE_DONE)
+        g_slice_free (PaxuiMoveRequest, d->data);
+    g_slice_free (PaxuiDelta, d);
+}
+
+static void
+delta_set_volume (PaxuiDelta *d, const pa_cvolume *volume, const pa_channel_map *chmap, int mute)
+{
+    d->volume = *volume;
+    d->channel_map = *chmap;
+    d->mute = mute;
+}
+
+static gboolean delta_drain (gpointer udata);
+static void volume_op_state_cb (pa_operation *op, void *udata);
+static void mute_op_state_cb (pa_operation *op, void *udata);
+static void event_schedule_flush (Paxui *paxui);
+
+/* any thread: push, waking the gtk thread if the stack was empty */
+static void
+delta_push (Paxui *paxui, PaxuiDelta *d)
+{
+    gpointer head;
+
+    do
     {
-        so = l->data;
+        head = g_atomic_pointer_get (&paxui->pa_deltas);
+        d->next = head;
+    }
+    while (!g_atomic_pointer_compare_and_exchange (&paxui->pa_deltas, head, d));
+
+    if (head == NULL)
+        g_idle_add_full (G_PRIORITY_DEFAULT, delta_drain, paxui, NULL);
+}
+
+
+/* Every request to the server goes through the tracker, which takes the
+ * operation's state callback for itself: on completion the time since
+ * it was sent goes into a latency histogram for its kind, & on cancel
+ * it is counted as such. Callers that want the state change give their
+ * callback to op_notify. Failures come from op_success_cb for requests
+ * with a success callback; an info callback seeing eol < 0 notes the
+ * error for the operation it belongs to, which completes right after.
+ * All of this runs under the mainloop lock. */
+
+typedef struct _PaxuiOp
+{
+    Paxui          *paxui;
+    guint           kind;
+    gint64          start;
+    pa_context_success_cb_t success;    /* chained from op_success_cb */
+    void           *success_data;
+    pa_operation_notify_cb_t notify;    /* chained from op_state_cb */
+    void           *notify_data;
+} PaxuiOp;
+
 
-        if (so->module == index) return so;
+static const gchar *
+op_kind_str (guint kind)
+{
+    switch (kind)
+    {
+        case PAXUI_OP_INFO_LIST:
+            return "info list";
+        case PAXUI_OP_INFO:
+            return "info";
+        case PAXUI_OP_SUBSCRIBE:
+            return "subscribe";
+        case PAXUI_OP_VOLUME:
+            return "volume";
+        case PAXUI_OP_MUTE:
+            return "mute";
+        case PAXUI_OP_MOVE:
+            return "move";
+        case PAXUI_OP_LOAD_MODULE:
+            return "load module";
+        case PAXUI_OP_UNLOAD_MODULE:
+            return "unload module";
+        default:
+            return "unknown";
     }
+}
+
+static PaxuiOp *
+op_new (Paxui *paxui, guint kind)
+{
+    PaxuiOp *t;
+
+    t = g_slice_new0 (PaxuiOp);
+    t->paxui = paxui;
+    t->kind = kind;
+    t->start = g_get_monotonic_time ();
 
-    return NULL;
+    return t;
 }
 
-static PaxuiLeaf *
-paxui_find_sink_input_for_module (const Paxui *paxui, guint32 index)
+static void
+op_free (PaxuiOp *t)
 {
-    GList *l;
-    PaxuiLeaf *si;
+    g_slice_free (PaxuiOp, t);
+}
+
+static void
+op_failed (Paxui *paxui, guint kind, int err)
+{
+    PaxuiOpStats *st = &paxui->op_stats[kind];
+
+    st->failed++;
+    st->last_errno = err;
+
+    DBG("%s request failed: %s", op_kind_str (kind), pa_strerror (err));
+}
+
+static void
+op_state_cb (pa_operation *op, void *udata)
+{
+    PaxuiOp *t = udata;
+    Paxui *paxui = t->paxui;
+    PaxuiOpStats *st = &paxui->op_stats[t->kind];
+    pa_operation_state_t state = pa_operation_get_state (op);
+    pa_operation_notify_cb_t notify;
+    void *notify_data;
+    gint64 usecs;
+    guint b;
+
+    if (state == PA_OPERATION_RUNNING) return;
+
+    if (state == PA_OPERATION_CANCELLED)
+    {
+        st->cancelled++;
+    }
+    else
+    {
+        usecs = g_get_monotonic_time () - t->start;
+
+        for (b = 0; b < PAXUI_OP_BUCKETS - 1 && usecs >= (PAXUI_OP_BUCKET0 << b); b++);
+        st->hist[b]++;
+        st->done++;
+        st->total_usecs += usecs;
+        if (usecs > st->max_usecs) st->max_usecs = usecs;
+
+        if (paxui->op_errno)
+        {
+            op_failed (paxui, t->kind, paxui->op_errno);
+            paxui->op_errno = 0;
+        }
+    }
+
+    notify = t->notify;
+    notify_data = t->notify_data;
+
+    /* frees t */
+    g_hash_table_remove (paxui->op_live, op);
+
+    if (notify) notify (op, notify_data);
+}
+
+static void
+op_success_cb (pa_context *c, int success, void *udata)
+{
+    PaxuiOp *t = udata;
+
+    if (!success) op_failed (t->paxui, t->kind, pa_context_errno (c));
+
+    if (t->success) t->success (c, success, t->success_data);
+}
+
+static void
+op_index_cb (pa_context *c, uint32_t idx, void *udata)
+{
+    PaxuiOp *t = udata;
+
+    if (idx == PA_INVALID_INDEX) op_failed (t->paxui, t->kind, pa_context_errno (c));
+}
+
+/* take charge of op made with t, which may be NULL if sending failed */
+static pa_operation *
+op_track (PaxuiOp *t, pa_operation *op)
+{
+    Paxui *paxui = t->paxui;
+
+    paxui->op_stats[t->kind].issued++;
 
-    for (l = paxui->sink_inputs; l; l = l->next)
+    if (op == NULL)
     {
-        si = l->data;
+        op_failed (paxui, t->kind, pa_context_errno (paxui->pa_ctx));
+        op_free (t);
+        return NULL;
+    }
+
+    g_hash_table_insert (paxui->op_live, op, t);
+    pa_operation_set_state_callback (op, op_state_cb, t);
+
+    return op;
+}
+
+/* follow op's completion with notify, or stop following with NULL */
+static void
+op_notify (Paxui *paxui, pa_operation *op, pa_operation_notify_cb_t notify, void *udata)
+{
+    PaxuiOp *t;
+
+    /* client stopped: every op was cancelled with the context */
+    if (paxui->op_live == NULL) return;
+
+    /* already complete */
+    if ((t = g_hash_table_lookup (paxui->op_live, op)) == NULL) return;
+
+    t->notify = notify;
+    t->notify_data = udata;
+}
+
+/* pa thread or gtk: an info callback got an error reply */
+static void
+op_info_failed (Paxui *paxui, pa_context *c)
+{
+    paxui->op_errno = pa_context_errno (c);
+    if (paxui->op_errno == 0) paxui->op_errno = PA_ERR_UNKNOWN;
+}
+
+
+void
+paxui_pulse_op_stats (Paxui *paxui, guint kind, PaxuiOpStats *stats)
+{
+    pulse_lock (paxui);
+    *stats = paxui->op_stats[kind];
+    pulse_unlock (paxui);
+}
+
+void
+paxui_pulse_op_stats_log (Paxui *paxui)
+{
+    PaxuiOpStats st;
+    GString *hist;
+    guint kind, b;
+
+    hist = g_string_new (NULL);
 
-        if (si->module == index) return si;
+    for (kind = 0; kind < PAXUI_OP_NUM_KINDS; kind++)
+    {
+        paxui_pulse_op_stats (paxui, kind, &st);
+        if (st.issued == 0) continue;
+
+        DBG("%s requests: %u sent, %u done, %u failed, %u cancelled, mean %.2fms, max %.2fms",
+            op_kind_str (kind), st.issued, st.done, st.failed, st.cancelled,
+            (st.done ? st.total_usecs / 1000.0 / st.done : 0.0), st.max_usecs / 1000.0);
+
+        g_string_truncate (hist, 0);
+        for (b = 0; b < PAXUI_OP_BUCKETS; b++)
+        {
+            if (st.hist[b] == 0) continue;
+
+            if (b < PAXUI_OP_BUCKETS - 1)
+                g_string_append_printf (hist, " <%.2fms:%u", (PAXUI_OP_BUCKET0 << b) / 1000.0, st.hist[b]);
+            else
+                g_string_append_printf (hist, " more:%u", st.hist[b]);
+        }
+        if (hist->len) DBG("   %s", hist->str);
+
+        if (st.failed) DBG("    last error: %s", pa_strerror (st.last_errno));
     }
 
-    return NULL;
+    g_string_free (hist, TRUE);
 }
 
 
+/* Each volume or mute set the server applies comes back as a change
+ * event. Change events carry no values, so they cannot be told apart
+ * from outside changes & are still fetched, but the fetch of a leaf is
+ * held while its own sets are in flight (see event_flush); a burst of
+ * echoes then costs one fetch once the leaf goes idle. Any fetch that
+ * does land mid-burst is checked against the sends not yet seen back:
+ * a value matching one with newer sends behind it is dropped. */
+
+static guint32
+volume_hash (const guint32 *values, guint n)
+{
+    guint32 h = 2166136261u;
+    guint i;
+
+    for (i = 0; i < n; i++)
+        h = (h ^ values[i]) * 16777619u;
+
+    return h ^ n;
+}
+
+/* note a sent value as awaited back, forgetting the oldest if full */
+static void
+echo_push (guint32 *ring, guint *n, guint32 value)
+{
+    if (*n == PAXUI_ECHO_RING)
+    {
+        memmove (ring, ring + 1, (PAXUI_ECHO_RING - 1) * sizeof (guint32));
+        (*n)--;
+    }
+    ring[(*n)++] = value;
+}
+
+/* whether a fetched value is the echo of a send that newer ones (or
+ * more) have overtaken; sends up to the one matched count as seen back,
+ * & a value matching none is an outside change that ends the wait */
+static gboolean
+echo_stale (guint32 *ring, guint *n, guint32 value, gboolean more)
+{
+    gboolean stale;
+    guint i;
+
+    for (i = *n; i-- > 0;)
+    {
+        if (ring[i] != value) continue;
+
+        stale = more || i + 1 < *n;
+        *n -= i + 1;
+        memmove (ring, ring + i + 1, *n * sizeof (guint32));
+        return stale;
+    }
+
+    *n = 0;
+    return FALSE;
+}
+
+static gboolean
+volume_busy (PaxuiLeaf *leaf)
+{
+    return leaf->vol && (leaf->vol->op || leaf->vol->queued || leaf->vol->mute_op);
+}
+
+/* the server has every send; a fetch now tells the truth */
+static void
+volume_idle (PaxuiLeaf *leaf)
+{
+    if (volume_busy (leaf)) return;
+
+    leaf->vol->n_echoes = 0;
+    leaf->vol->n_mute_echoes = 0;
+
+    /* fetches held back for this leaf */
+    event_schedule_flush (leaf->paxui);
+}
+
+
+/* stop following the set-mute in flight, if any */
+static void
+mute_cancel (PaxuiLeaf *leaf)
+{
+    if (leaf->vol->mute_op == NULL) return;
+
+    pulse_lock (leaf->paxui);
+    op_notify (leaf->paxui, leaf->vol->mute_op, NULL, NULL);
+    pa_operation_unref (leaf->vol->mute_op);
+    pulse_unlock (leaf->paxui);
+
+    leaf->vol->mute_op = NULL;
+}
+
+static void
+mute_op_done (PaxuiLeaf *leaf)
+{
+    mute_cancel (leaf);
+    volume_idle (leaf);
+}
+
+static void
+mute_op_state_cb (pa_operation *op, void *udata)
+{
+    PaxuiLeaf *leaf = udata;
+    PaxuiDelta *d;
+
+    if (pa_operation_get_state (op) == PA_OPERATION_RUNNING) return;
+
+    if (leaf->paxui->pa_tml == NULL)
+    {
+        mute_op_done (leaf);
+        return;
+    }
+
+    d = delta_new (NULL, PAXUI_DELTA_MUTE_DONE, 0);
+    d->index = leaf->index;
+    d->event = leaf->leaf_type;
+    d->seq = leaf->vol->mute_seq;
+    delta_push (leaf->paxui, d);
+}
+
 void
 paxui_pulse_mute_set (PaxuiLeaf *leaf)
 {
+    pa_operation *op = NULL;
+    PaxuiOp *t;
+
     DBG("set mute i:%u m:%d", leaf->index, leaf->muted);
 
+    /* the one in flight still comes back as an echo */
+    mute_cancel (leaf);
+
+    pulse_lock (leaf->paxui);
+    leaf->vol->mute_seq++;
+    t = op_new (leaf->paxui, PAXUI_OP_MUTE);
     switch (leaf->leaf_type)
     {
         case PAXUI_LEAF_TYPE_SOURCE:
-            pa_context_set_source_mute_by_index (
-                    leaf->paxui->pa_ctx, leaf->index, leaf->muted, NULL, NULL);
+            op = pa_context_set_source_mute_by_index (
+                    leaf->paxui->pa_ctx, leaf->index, leaf->muted, op_success_cb, t);
             break;
         case PAXUI_LEAF_TYPE_SINK:
-            pa_context_set_sink_mute_by_index (
-                    leaf->paxui->pa_ctx, leaf->index, leaf->muted, NULL, NULL);
+            op = pa_context_set_sink_mute_by_index (
+                    leaf->paxui->pa_ctx, leaf->index, leaf->muted, op_success_cb, t);
             break;
         case PAXUI_LEAF_TYPE_SOURCE_OUTPUT:
-            pa_context_set_source_output_mute (
-                    leaf->paxui->pa_ctx, leaf->index, leaf->muted, NULL, NULL);
+            op = pa_context_set_source_output_mute (
+                    leaf->paxui->pa_ctx, leaf->index, leaf->muted, op_success_cb, t);
             break;
         case PAXUI_LEAF_TYPE_SINK_INPUT:
-            pa_context_set_sink_input_mute (
-                    leaf->paxui->pa_ctx, leaf->index, leaf->muted, NULL, NULL);
+            op = pa_context_set_sink_input_mute (
+                    leaf->paxui->pa_ctx, leaf->index, leaf->muted, op_success_cb, t);
             break;
     }
+    if (op_track (t, op))
+        op_notify (leaf->paxui, op, mute_op_state_cb, leaf);
+    pulse_unlock (leaf->paxui);
+
+    leaf->vol->mute_op = op;
+    if (op == NULL) return;
+
+    echo_push (leaf->vol->mute_echoes, &leaf->vol->n_mute_echoes, leaf->muted);
 }
 
-void
-paxui_pulse_volume_set (PaxuiLeaf *leaf)
+/* One set-volume per leaf is kept in flight. Slider moves while it is
+ * out only mark the leaf; when it completes the levels as they are then
+ * are sent, so a drag costs at most one operation per round trip. */
+
+static void
+volume_send (PaxuiLeaf *leaf)
 {
     pa_cvolume volume;
+    pa_operation *op = NULL;
+    PaxuiOp *t;
+    guint32 hash;
     guint i;
 
+    /* slider steps can round to the levels already sent or reported */
+    hash = volume_hash (leaf->vol->levels, leaf->vol->n_chan);
+    if (hash == leaf->vol->sent_hash) return;
+
     DBG("set volume i:%u", leaf->index);
 
     pa_cvolume_init (&volume);
-    volume.channels = leaf->n_chan;
-    for (i = 0; i < leaf->n_chan; i++)
-        volume.values[i] = leaf->levels[i];
+    volume.channels = leaf->vol->n_chan;
+    for (i = 0; i < leaf->vol->n_chan; i++)
+        volume.values[i] = leaf->vol->levels[i];
 
+    pulse_lock (leaf->paxui);
+    leaf->vol->seq++;
+    t = op_new (leaf->paxui, PAXUI_OP_VOLUME);
     switch (leaf->leaf_type)
     {
         case PAXUI_LEAF_TYPE_SOURCE:
-            pa_context_set_source_volume_by_index (
-                    leaf->paxui->pa_ctx, leaf->index, &volume, NULL, NULL);
+            op = pa_context_set_source_volume_by_index (
+                    leaf->paxui->pa_ctx, leaf->index, &volume, op_success_cb, t);
             break;
         case PAXUI_LEAF_TYPE_SINK:
-            pa_context_set_sink_volume_by_index (
-                    leaf->paxui->pa_ctx, leaf->index, &volume, NULL, NULL);
+            op = pa_context_set_sink_volume_by_index (
+                    leaf->paxui->pa_ctx, leaf->index, &volume, op_success_cb, t);
             break;
         case PAXUI_LEAF_TYPE_SOURCE_OUTPUT:
-            pa_context_set_source_output_volume (
-                    leaf->paxui->pa_ctx, leaf->index, &volume, NULL, NULL);
+            op = pa_context_set_source_output_volume (
+                    leaf->paxui->pa_ctx, leaf->index, &volume, op_success_cb, t);
             break;
         case PAXUI_LEAF_TYPE_SINK_INPUT:
-            pa_context_set_sink_input_volume (
-                    leaf->paxui->pa_ctx, leaf->index, &volume, NULL, NULL);
+            op = pa_context_set_sink_input_volume (
+                    leaf->paxui->pa_ctx, leaf->index, &volume, op_success_cb, t);
             break;
     }
+    if (op_track (t, op))
+        op_notify (leaf->paxui, op, volume_op_state_cb, leaf);
+    pulse_unlock (leaf->paxui);
+
+    leaf->vol->op = op;
+    if (op == NULL) return;
+
+    leaf->vol->sent_hash = hash;
+    echo_push (leaf->vol->echoes, &leaf->vol->n_echoes, hash);
+}
+
+/* stop following the set-volume in flight, if any */
+static void
+volume_cancel (PaxuiLeaf *leaf)
+{
+    if (leaf->vol->op == NULL) return;
+
+    pulse_lock (leaf->paxui);
+    op_notify (leaf->paxui, leaf->vol->op, NULL, NULL);
+    pa_operation_unref (leaf->vol->op);
+    pulse_unlock (leaf->paxui);
+
+    leaf->vol->op = NULL;
+}
+
+/* stop following volume & mute sets, the leaf is going */
+void
+paxui_pulse_volume_cancel (PaxuiLeaf *leaf)
+{
+    if (leaf->vol == NULL) return;
+
+    volume_cancel (leaf);
+    mute_cancel (leaf);
+}
+
+static void
+volume_op_done (PaxuiLeaf *leaf)
+{
+    volume_cancel (leaf);
+
+    if (leaf->vol->queued)
+    {
+        leaf->vol->queued = FALSE;
+        volume_send (leaf);
+    }
+
+    volume_idle (leaf);
+}
+
+static void
+volume_op_state_cb (pa_operation *op, void *udata)
+{
+    PaxuiLeaf *leaf = udata;
+    PaxuiDelta *d;
+
+    if (pa_operation_get_state (op) == PA_OPERATION_RUNNING) return;
+
+    if (leaf->paxui->pa_tml == NULL)
+    {
+        volume_op_done (leaf);
+        return;
+    }
+
+    /* leaf may be gone by the time this is applied */
+    d = delta_new (NULL, PAXUI_DELTA_VOLUME_DONE, 0);
+    d->index = leaf->index;
+    d->event = leaf->leaf_type;
+    d->seq = leaf->vol->seq;
+    delta_push (leaf->paxui, d);
+}
+
+void
+paxui_pulse_volume_set (PaxuiLeaf *leaf)
+{
+    if (leaf->vol->op)
+    {
+        TRACE("volume set held back i:%u", leaf->index);
+        leaf->vol->queued = TRUE;
+        return;
+    }
+
+    volume_send (leaf);
+}
+
+/* slider let go: send the final levels now, not after the one in flight */
+void
+paxui_pulse_volume_flush (PaxuiLeaf *leaf)
+{
+    if (!leaf->vol->queued) return;
+
+    leaf->vol->queued = FALSE;
+    volume_cancel (leaf);
+    volume_send (leaf);
+    volume_idle (leaf);
 }
 
 
 void
 paxui_pulse_load_module (Paxui *paxui, const gchar *mod_name, const gchar *mod_arg)
 {
-    pa_operation_unref (
-        pa_context_load_module (paxui->pa_ctx, mod_name, mod_arg, NULL, NULL));
+    pa_operation *op;
+    PaxuiOp *t;
+
+    pulse_lock (paxui);
+    t = op_new (paxui, PAXUI_OP_LOAD_MODULE);
+    op = pa_context_load_module (paxui->pa_ctx, mod_name, mod_arg, op_index_cb, t);
+    if (op_track (t, op)) pa_operation_unref (op);
+    pulse_unlock (paxui);
 }
 
 void
 paxui_pulse_unload_module (Paxui *paxui, guint32 index)
 {
-    pa_operation_unref (
-        pa_context_unload_module (paxui->pa_ctx, index, NULL, NULL));
+    pa_operation *op;
+    PaxuiOp *t;
+
+    pulse_lock (paxui);
+    t = op_new (paxui, PAXUI_OP_UNLOAD_MODULE);
+    op = pa_context_unload_module (paxui->pa_ctx, index, op_success_cb, t);
+    if (op_track (t, op)) pa_operation_unref (op);
+    pulse_unlock (paxui);
+}
+
+
+/* A stream move is shown at once: the stream is switched to its new
+ * device in the model when the move is sent, & switched back with an
+ * error shown if the server refuses it. Until the server answers, info
+ * replies for the stream don't change its device: they may have been
+ * sent before the move. */
+
+static void
+stream_set_device (PaxuiLeaf *stream, guint32 device)
+{
+    paxui_stream_unlink (stream);
+    if (stream->leaf_type == PAXUI_LEAF_TYPE_SINK_INPUT)
+        stream->sink = device;
+    else
+        stream->source = device;
+    paxui_stream_link (stream);
+
+    paxui_gui_touch_leaf (stream);
+    paxui_gui_update_now (stream->paxui);
+}
+
+static void
+move_error (PaxuiMoveRequest *req, const gchar *err)
+{
+    gchar *msg;
+
+    msg = g_strdup_printf ("Move of %s #%u failed: %s",
+                (req->leaf_type == PAXUI_LEAF_TYPE_SINK_INPUT ? "sink input" : "source output"),
+                req->index, (err ? err : "unknown error"));
+    paxui_gui_show_error (req->paxui, msg);
+    g_free (msg);
+}
+
+static void
+move_done (PaxuiMoveRequest *req, int success, const gchar *err)
+{
+    PaxuiLeaf *stream;
+    guint32 device;
+
+    DBG("move of %u to %u done sx:%d", req->index, req->to, success);
+
+    stream = paxui_find_leaf_for_index (req->paxui, req->leaf_type, req->index);
+    if (stream && stream->moves_pending) stream->moves_pending--;
+
+    if (success || stream == NULL) return;
+
+    /* leave it if it has been moved again since */
+    device = (req->leaf_type == PAXUI_LEAF_TYPE_SINK_INPUT ? stream->sink : stream->source);
+    if (device != req->to) return;
+
+    stream_set_device (stream, req->from);
+    move_error (req, err);
+}
+
+static void
+move_cb (pa_context *c, int success, void *udata)
+{
+    PaxuiMoveRequest *req = udata;
+    PaxuiDelta *d;
+
+    if (req->paxui->pa_tml == NULL)
+    {
+        move_done (req, success, (success ? NULL : pa_strerror (pa_context_errno (c))));
+        g_slice_free (PaxuiMoveRequest, req);
+        return;
+    }
+
+    d = delta_new (c, PAXUI_DELTA_MOVE_DONE, success);
+    d->data = req;
+    if (!success) d->text = g_strdup (pa_strerror (pa_context_errno (c)));
+    delta_push (req->paxui, d);
+}
+
+static void
+stream_move (PaxuiLeaf *stream, guint32 device)
+{
+    Paxui *paxui = stream->paxui;
+    PaxuiMoveRequest *req;
+    pa_operation *op;
+    PaxuiOp *t;
+    gchar *err = NULL;
+
+    req = g_slice_new (PaxuiMoveRequest);
+    req->paxui = paxui;
+    req->leaf_type = stream->leaf_type;
+    req->index = stream->index;
+    req->from = (stream->leaf_type == PAXUI_LEAF_TYPE_SINK_INPUT ? stream->sink : stream->source);
+    req->to = device;
+
+    pulse_lock (paxui);
+    t = op_new (paxui, PAXUI_OP_MOVE);
+    t->success = move_cb;
+    t->success_data = req;
+    if (stream->leaf_type == PAXUI_LEAF_TYPE_SINK_INPUT)
+        op = pa_context_move_sink_input_by_index (paxui->pa_ctx, stream->index, device, op_success_cb, t);
+    else
+        op = pa_context_move_source_output_by_index (paxui->pa_ctx, stream->index, device, op_success_cb, t);
+    if (op_track (t, op))
+        pa_operation_unref (op);
+    else
+        err = g_strdup (pa_strerror (pa_context_errno (paxui->pa_ctx)));
+    pulse_unlock (paxui);
+
+    if (op == NULL)
+    {
+        move_error (req, err);
+        g_free (err);
+        g_slice_free (PaxuiMoveRequest, req);
+        return;
+    }
+
+    stream->moves_pending++;
+    stream_set_device (stream, device);
 }
 
 
 void
 paxui_pulse_move_source_output (Paxui *paxui, guint32 so_index, guint32 sc_index)
 {
-    GList *l;
+    PaxuiLeaf *so;
 
     DBG("move source_output:%u to source:%u", so_index, sc_index);
 
-    for (l = paxui->source_outputs; l; l = l->next)
+    if ((so = paxui_find_source_output_for_index (paxui, so_index)) == NULL)
     {
-        PaxuiLeaf *so = l->data;
-
-        if (so->index == so_index)
-        {
-            if (so->source == sc_index)
-            {
-                DBG("    already connected");
-            }
-            else
-            {
-                DBG("    moving...");
+        DBG("    unknown data");
+        return;
+    }
 
-                pa_context_move_source_output_by_index (
-                            paxui->pa_ctx, so_index, sc_index, NULL, NULL);
-            }
+    if (so->source == sc_index)
+    {
+        DBG("    already connected");
+    }
+    else
+    {
+        DBG("    moving...");
 
-            return;
-        }
+        stream_move (so, sc_index);
     }
-    DBG("    unknown data");
 }
 
 
 void
 paxui_pulse_move_sink_input (Paxui *paxui, guint32 si_index, guint32 sk_index)
 {
-    GList *l;
+    PaxuiLeaf *si;
 
     DBG("move sink_input:%u to sink:%u", si_index, sk_index);
 
-    for (l = paxui->sink_inputs; l; l = l->next)
+    if ((si = paxui_find_sink_input_for_index (paxui, si_index)) == NULL)
     {
-        PaxuiLeaf *si = l->data;
-
-        if (si->index == si_index)
-        {
-            if (si->sink == sk_index)
-            {
-                DBG("    already connected");
-            }
-            else
-            {
-                DBG("    moving...");
+        DBG("    unknown data");
+        return;
+    }
 
-                pa_context_move_sink_input_by_index (
-                            paxui->pa_ctx, si_index, sk_index, NULL, NULL);
-            }
+    if (si->sink == sk_index)
+    {
+        DBG("    already connected");
+    }
+    else
+    {
+        DBG("    moving...");
 
-            return;
-        }
+        stream_move (si, sk_index);
     }
-    DBG("    unknown data");
 }
 
 
 static void
 update_volume (PaxuiLeaf *leaf, const pa_cvolume *volume)
 {
+    guint32 hash;
     guint i;
 
-    for (i = 0; i < leaf->n_chan; i++)
-        leaf->levels[i] = volume->values[i];
+    /* an earlier send coming back while the slider has moved on */
+    hash = volume_hash (volume->values, volume->channels);
+    if (echo_stale (leaf->vol->echoes, &leaf->vol->n_echoes, hash, leaf->vol->queued))
+    {
+        TRACE("    volume echo skipped i:%u", leaf->index);
+        return;
+    }
+
+    /* a send is only skipped if it repeats what the server has */
+    leaf->vol->sent_hash = hash;
+
+    for (i = 0; i < leaf->vol->n_chan; i++)
+    {
+        if (leaf->vol->levels[i] == volume->values[i]) continue;
+
+        leaf->vol->levels[i] = volume->values[i];
+        leaf->dirty |= PAXUI_DIRTY_VOLUME;
+    }
+}
+
+static void
+update_mute (PaxuiLeaf *leaf, int mute)
+{
+    if (echo_stale (leaf->vol->mute_echoes, &leaf->vol->n_mute_echoes, !!mute, FALSE))
+    {
+        TRACE("    mute echo skipped i:%u", leaf->index);
+        return;
+    }
+
+    if (leaf->muted == !!mute) return;
+
+    leaf->muted = !!mute;
+    leaf->dirty |= PAXUI_DIRTY_MUTE;
 }
 
 
@@ -464,16 +1114,107 @@ copy_volume_chmap (PaxuiLeaf *leaf, const pa_cvolume *volume, const pa_channel_m
 {
     guint i;
 
-    leaf->n_chan = volume->channels;
-    leaf->n_pos = chmap->channels;
+    if (leaf->vol == NULL)
+    {
+        leaf->vol = g_slice_new0 (PaxuiVolume);
+        paxui_leaf_update_owned (leaf);
+    }
+
+    leaf->vol->n_chan = volume->channels;
+    leaf->vol->n_pos = chmap->channels;
+
+    for (i = 0; i < leaf->vol->n_pos; i++)
+        leaf->vol->positions[i] = chmap->map[i];
+}
+
+static void event_queue (pa_subscription_event_type_t facility, uint32_t idx, Paxui *paxui);
+
+/* count off the initial info lists; when all are in, build the gui */
+static void
+initial_list_end (Paxui *paxui, int eol)
+{
+    if (!paxui->loading || eol == 0) return;
+
+    if (eol < 0)
+    {
+        pulse_lock (paxui);
+        DBG("info list failed: %s", pa_strerror (pa_context_errno (paxui->pa_ctx)));
+        pulse_unlock (paxui);
+    }
+
+    if (--paxui->lists_pending > 0) return;
+
+    DBG("initial lists complete");
+
+    paxui->loading = FALSE;
+    paxui_gui_populate (paxui);
+
+    /* send info requests for anything changed during loading */
+    event_schedule_flush (paxui);
+}
+
+/* In lazy mode the client & module lists are not fetched; a client or
+ * module is asked for by index when a stream refers to it, with a
+ * nameless placeholder leaf standing in until its info arrives. */
+static PaxuiLeaf *
+owner_fetch (Paxui *paxui, guint leaf_type, guint32 index)
+{
+    PaxuiLeaf *owner;
+
+    if (index == G_MAXUINT32) return NULL;
+
+    if ((owner = paxui_find_leaf_for_index (paxui, leaf_type, index))) return owner;
+
+    DBG("fetching %s:%u on demand", (leaf_type == PAXUI_LEAF_TYPE_CLIENT ? "client" : "module"), index);
+
+    owner = paxui_leaf_new (paxui, leaf_type);
+    owner->index = index;
+    paxui_leaf_register (owner);
+
+    /* a background request like any refresh; during loading it waits
+     * for the lists, & the owner's widgets come when its info does */
+    event_queue ((leaf_type == PAXUI_LEAF_TYPE_CLIENT ?
+                    PA_SUBSCRIPTION_EVENT_CLIENT : PA_SUBSCRIPTION_EVENT_MODULE),
+                 index, paxui);
+
+    return owner;
+}
+
+/* client-less sink inputs are filtered on their module's name, so in
+ * lazy mode they wait for the module info before being taken in */
+static void
+owner_wait (Paxui *paxui, guint32 module, guint32 sink_input)
+{
+    gpointer key = GUINT_TO_POINTER (module);
+    GArray *waiting;
+
+    if ((waiting = g_hash_table_lookup (paxui->owner_waits, key)) == NULL)
+    {
+        waiting = g_array_new (FALSE, FALSE, sizeof (guint32));
+        g_hash_table_insert (paxui->owner_waits, key, waiting);
+    }
+    g_array_append_val (waiting, sink_input);
+
+    owner_fetch (paxui, PAXUI_LEAF_TYPE_MODULE, module);
+}
+
+/* module info is in: ask again for the sink inputs held back on it */
+static void
+owner_release (Paxui *paxui, guint32 module)
+{
+    gpointer key = GUINT_TO_POINTER (module);
+    GArray *waiting;
+    guint i;
+
+    if ((waiting = g_hash_table_lookup (paxui->owner_waits, key)) == NULL) return;
 
-    leaf->levels = g_new (guint32, MAX (leaf->n_chan, leaf->n_pos));
-    leaf->positions = g_new (guint32, MAX (leaf->n_chan, leaf->n_pos));
+    for (i = 0; i < waiting->len; i++)
+        event_queue (PA_SUBSCRIPTION_EVENT_SINK_INPUT, g_array_index (waiting, guint32, i), paxui);
 
-    for (i = 0; i < leaf->n_pos; i++)
-        leaf->positions[i] = chmap->map[i];
+    g_hash_table_remove (paxui->owner_waits, key);
 }
 
+
 static void
 client_info_cb (pa_context *c, const pa_client_info *info, int eol, void *udata)
 {
@@ -481,7 +1222,27 @@ client_info_cb (pa_context *c, const pa_client_info *info, int eol, void *udata)
     PaxuiLeaf *client;
     gboolean is_new = FALSE;
 
-    if (eol > 0 || info == NULL) return;
+    if (c && eol < 0) op_info_failed (paxui, c);
+
+    if (c && paxui->pa_tml)
+    {
+        PaxuiDelta *d = delta_new (c, PAXUI_DELTA_CLIENT, eol);
+
+        if (eol == 0 && info)
+        {
+            d->index = info->index;
+            d->owner_module = info->owner_module;
+            d->name = g_strdup (info->name);
+        }
+        delta_push (paxui, d);
+        return;
+    }
+
+    if (eol > 0 || info == NULL)
+    {
+        initial_list_end (paxui, eol);
+        return;
+    }
 
     DBG("client info index:%u '%s' mod:%u", info->index, info->name, info->owner_module);
 
@@ -492,25 +1253,31 @@ client_info_cb (pa_context *c, const pa_client_info *info, int eol, void *udata)
     else
     {
         is_new = TRUE;
-        client = paxui_leaf_new (PAXUI_LEAF_TYPE_CLIENT);
+        client = paxui_leaf_new (paxui, PAXUI_LEAF_TYPE_CLIENT);
         client->index = info->index;
-        client->paxui = paxui;
-
-        client->module = info->owner_module;
 
-        paxui->clients = g_list_append (paxui->clients, client);
+        paxui_leaf_register (client);
     }
 
+    client->module = info->owner_module;
+
     leaf_get_strings (client, info->name);
 
-    if (client->outer == NULL)
+    /* module name is used to match saved positions */
+    if (paxui->lazy_blocks)
+        owner_fetch (paxui, PAXUI_LEAF_TYPE_MODULE, client->module);
+
+    /* widgets are built in one go once the initial lists are in */
+    if (paxui->loading) return;
+
+    if (client->view == NULL)
     {
         paxui_block_update_active (client, paxui);
         if (client->active)
         {
             DBG("  adding gui");
             leaf_gui_new (client);
-            paxui_gui_trigger_update (paxui);
+            paxui_gui_touch_leaf (client);
         }
     }
 
@@ -526,7 +1293,27 @@ module_info_cb (pa_context *c, const pa_module_info *info, int eol, void *udata)
     Paxui *paxui = udata;
     gboolean is_new = FALSE;
 
-    if (eol > 0 || info == NULL) return;
+    if (c && eol < 0) op_info_failed (paxui, c);
+
+    if (c && paxui->pa_tml)
+    {
+        PaxuiDelta *d = delta_new (c, PAXUI_DELTA_MODULE, eol);
+
+        if (eol == 0 && info)
+        {
+            d->index = info->index;
+            d->name = g_strdup (info->name);
+            d->text = g_strdup (info->argument);
+        }
+        delta_push (paxui, d);
+        return;
+    }
+
+    if (eol > 0 || info == NULL)
+    {
+        initial_list_end (paxui, eol);
+        return;
+    }
 
     DBG("module info index:%u '%s' '%s'", info->index, info->name, info->argument);
 
@@ -536,44 +1323,51 @@ module_info_cb (pa_context *c, const pa_module_info *info, int eol, void *udata)
     }
     else
     {
-        PaxuiLeaf *lf;
-
         is_new = TRUE;
-        module = paxui_leaf_new (PAXUI_LEAF_TYPE_MODULE);
+        module = paxui_leaf_new (paxui, PAXUI_LEAF_TYPE_MODULE);
         module->index = info->index;
-        module->paxui = paxui;
 
-        paxui->modules = g_list_append (paxui->modules, module);
+        paxui_leaf_register (module);
+    }
+
+    /* new, or a placeholder made for a stream's owner */
+    if (module->name == NULL)
+    {
+        PaxuiLeaf *lf;
+        GHashTable *streams;
 
         leaf_get_strings (module, info->name);
 
-        if ((lf = paxui_find_source_output_for_module (paxui, module->index))
-            && lf->client == G_MAXUINT32)
+        if ((streams = paxui_streams_for_leaf (module)))
         {
-            DBG("    so for this module already exists");
+            GHashTableIter iter;
 
-            g_free (lf->short_name);
-            lf->short_name = make_owner_module_name (module->utf8_name, info->index);
-            leaf_gui_update (lf);
-        }
-        if ((lf = paxui_find_sink_input_for_module (paxui, module->index))
-            && lf->client == G_MAXUINT32)
-        {
-            DBG("    si for this module already exists");
+            g_hash_table_iter_init (&iter, streams);
+            while (g_hash_table_iter_next (&iter, (gpointer *) &lf, NULL))
+            {
+                if (lf->client != G_MAXUINT32) continue;
+
+                DBG("    so/si:%u for this module already exists", lf->index);
 
-            g_free (lf->short_name);
-            lf->short_name = make_owner_module_name (module->utf8_name, info->index);
-            leaf_gui_update (lf);
+                leaf_set_owner_module_name (lf, module);
+                lf->dirty |= PAXUI_DIRTY_NAME;
+                leaf_gui_update (lf);
+            }
         }
+
+        owner_release (paxui, module->index);
     }
 
-    if (module->outer == NULL)
+    /* widgets are built in one go once the initial lists are in */
+    if (paxui->loading) return;
+
+    if (module->view == NULL)
     {
         paxui_block_update_active (module, paxui);
         if (module->active)
         {
             leaf_gui_new (module);
-            paxui_gui_trigger_update (paxui);
+            paxui_gui_touch_leaf (module);
         }
     }
 
@@ -587,9 +1381,34 @@ source_output_info_cb (pa_context *c, const pa_source_output_info *info, int eol
 {
     Paxui *paxui = udata;
     PaxuiLeaf *source_output;
-    gboolean is_new = FALSE;
+    gboolean is_new = FALSE, moved = FALSE;
 
-    if (eol > 0 || info == NULL) return;
+    if (c && eol < 0) op_info_failed (paxui, c);
+
+    if (c && paxui->pa_tml)
+    {
+        PaxuiDelta *d = delta_new (c, PAXUI_DELTA_SOURCE_OUTPUT, eol);
+
+        if (eol == 0 && info)
+        {
+            d->index = info->index;
+            d->owner_module = info->owner_module;
+            d->client = info->client;
+            d->device = info->source;
+            d->name = g_strdup (info->name);
+            d->has_volume = info->has_volume;
+            d->volume_writable = info->volume_writable;
+            delta_set_volume (d, &info->volume, &info->channel_map, info->mute);
+        }
+        delta_push (paxui, d);
+        return;
+    }
+
+    if (eol > 0 || info == NULL)
+    {
+        initial_list_end (paxui, eol);
+        return;
+    }
 
     DBG("source_output info index:%u '%s' client:%u src:%u", info->index, info->name, info->client, info->source);
 
@@ -600,9 +1419,8 @@ source_output_info_cb (pa_context *c, const pa_source_output_info *info, int eol
     else
     {
         is_new = TRUE;
-        source_output = paxui_leaf_new (PAXUI_LEAF_TYPE_SOURCE_OUTPUT);
+        source_output = paxui_leaf_new (paxui, PAXUI_LEAF_TYPE_SOURCE_OUTPUT);
         source_output->index = info->index;
-        source_output->paxui = paxui;
 
         source_output->module = info->owner_module;
         source_output->client = info->client;
@@ -611,31 +1429,50 @@ source_output_info_cb (pa_context *c, const pa_source_output_info *info, int eol
         if (source_output->vol_enabled)
             copy_volume_chmap (source_output, &info->volume, &info->channel_map);
 
-        paxui->source_outputs = g_list_append (paxui->source_outputs, source_output);
+        paxui_leaf_register (source_output);
+
+        if (paxui->lazy_blocks)
+        {
+            if (source_output->client != G_MAXUINT32)
+                owner_fetch (paxui, PAXUI_LEAF_TYPE_CLIENT, source_output->client);
+            else
+                owner_fetch (paxui, PAXUI_LEAF_TYPE_MODULE, source_output->module);
+        }
 
     }
 
-    source_output->source = info->source;
+    /* a reply sent before a move still in flight has the old source */
+    if (source_output->source != info->source && source_output->moves_pending == 0)
+    {
+        paxui_stream_unlink (source_output);
+        source_output->source = info->source;
+        moved = TRUE;
+    }
+    paxui_stream_link (source_output);
 
     leaf_get_strings (source_output, info->name);
 
     if (source_output->vol_enabled)
     {
         update_volume (source_output, &info->volume);
-        source_output->muted = !!info->mute;
+        update_mute (source_output, info->mute);
     }
 
+    /* widgets are built in one go once the initial lists are in */
+    if (paxui->loading) return;
+
     if (source_output->client != G_MAXUINT32)
     {
         PaxuiLeaf *cl;
 
         cl = paxui_find_client_for_index (paxui, source_output->client);
-        if (cl && cl->outer == NULL)
+        /* a lazy placeholder gets widgets once its info is in */
+        if (cl && cl->view == NULL && cl->name)
         {
             DBG("    adding gui for client:%u", source_output->client);
 
             leaf_gui_new (cl);
-            paxui_gui_trigger_update (paxui);
+            paxui_gui_touch_leaf (cl);
         }
     }
     else if (source_output->module != G_MAXUINT32)
@@ -643,23 +1480,24 @@ source_output_info_cb (pa_context *c, const pa_source_output_info *info, int eol
         PaxuiLeaf *md;
 
         md = paxui_find_module_for_index (paxui, source_output->module);
-        if (md && md->outer == NULL)
+        if (md && md->view == NULL && md->name)
         {
             DBG("    adding gui for module:%u", source_output->module);
 
             leaf_gui_new (md);
-            paxui_gui_trigger_update (paxui);
+            paxui_gui_touch_leaf (md);
         }
     }
 
     if (is_new)
     {
         leaf_gui_new (source_output);
-        paxui_gui_trigger_update (paxui);
+        paxui_gui_touch_leaf (source_output);
     }
     else
     {
         leaf_gui_update (source_output);
+        if (moved) paxui_gui_touch_leaf (source_output);
     }
 }
 
@@ -671,7 +1509,30 @@ source_info_cb (pa_context *c, const pa_source_info *info, int eol, void *udata)
     PaxuiLeaf *source;
     gboolean is_new = FALSE;
 
-    if (eol > 0 || info == NULL) return;
+    if (c && eol < 0) op_info_failed (paxui, c);
+
+    if (c && paxui->pa_tml)
+    {
+        PaxuiDelta *d = delta_new (c, PAXUI_DELTA_SOURCE, eol);
+
+        if (eol == 0 && info)
+        {
+            d->index = info->index;
+            d->owner_module = info->owner_module;
+            d->device = info->monitor_of_sink;
+            d->name = g_strdup (info->name);
+            d->text = g_strdup (info->description);
+            delta_set_volume (d, &info->volume, &info->channel_map, info->mute);
+        }
+        delta_push (paxui, d);
+        return;
+    }
+
+    if (eol > 0 || info == NULL)
+    {
+        initial_list_end (paxui, eol);
+        return;
+    }
 
     DBG("source info index:%u '%s' '%s'", info->index, info->name, info->description);
 
@@ -682,9 +1543,8 @@ source_info_cb (pa_context *c, const pa_source_info *info, int eol, void *udata)
     else
     {
         is_new = TRUE;
-        source = paxui_leaf_new (PAXUI_LEAF_TYPE_SOURCE);
+        source = paxui_leaf_new (paxui, PAXUI_LEAF_TYPE_SOURCE);
         source->index = info->index;
-        source->paxui = paxui;
 
         source->module = info->owner_module;
         source->monitor = info->monitor_of_sink;
@@ -693,7 +1553,7 @@ source_info_cb (pa_context *c, const pa_source_info *info, int eol, void *udata)
         if (source->vol_enabled)
             copy_volume_chmap (source, &info->volume, &info->channel_map);
 
-        paxui->sources = g_list_append (paxui->sources, source);
+        paxui_leaf_register (source);
 
         leaf_get_strings (source, info->name);
     }
@@ -701,15 +1561,20 @@ source_info_cb (pa_context *c, const pa_source_info *info, int eol, void *udata)
     if (source->vol_enabled)
     {
         update_volume (source, &info->volume);
-        source->muted = !!info->mute;
+        update_mute (source, info->mute);
     }
 
+    /* widgets are built in one go once the initial lists are in */
+    if (paxui->loading) return;
+
+    /* relayout only if the widget may have changed size */
+    if (is_new || (source->dirty & PAXUI_DIRTY_NAME))
+        paxui_gui_trigger_update (paxui);
+
     if (is_new)
         leaf_gui_new (source);
     else
         leaf_gui_update (source);
-
-    paxui_gui_trigger_update (paxui);
 }
 
 
@@ -718,9 +1583,34 @@ sink_input_info_cb (pa_context *c, const pa_sink_input_info *info, int eol, void
 {
     Paxui *paxui = udata;
     PaxuiLeaf *sink_input;
-    gboolean is_new = FALSE;
+    gboolean is_new = FALSE, moved = FALSE;
 
-    if (eol > 0 || info == NULL) return;
+    if (c && eol < 0) op_info_failed (paxui, c);
+
+    if (c && paxui->pa_tml)
+    {
+        PaxuiDelta *d = delta_new (c, PAXUI_DELTA_SINK_INPUT, eol);
+
+        if (eol == 0 && info)
+        {
+            d->index = info->index;
+            d->owner_module = info->owner_module;
+            d->client = info->client;
+            d->device = info->sink;
+            d->name = g_strdup (info->name);
+            d->has_volume = info->has_volume;
+            d->volume_writable = info->volume_writable;
+            delta_set_volume (d, &info->volume, &info->channel_map, info->mute);
+        }
+        delta_push (paxui, d);
+        return;
+    }
+
+    if (eol > 0 || info == NULL)
+    {
+        initial_list_end (paxui, eol);
+        return;
+    }
 
     DBG("sink_input info index:%u '%s' client:%u sink:%u", info->index, info->name, info->client, info->sink);
 
@@ -731,7 +1621,19 @@ sink_input_info_cb (pa_context *c, const pa_sink_input_info *info, int eol, void
 
         module = paxui_find_module_for_index  (paxui, info->owner_module);
 
-        if (module && g_strcmp0 (module->name, "module-loopback")) return;
+        if (paxui->lazy_blocks && info->owner_module != G_MAXUINT32 &&
+            (module == NULL || module->name == NULL))
+        {
+            owner_wait (paxui, info->owner_module, info->index);
+            return;
+        }
+
+        if (module && g_strcmp0 (module->name, "module-loopback"))
+        {
+            /* later change events for it are dropped unasked */
+            g_hash_table_add (paxui->ignored_sis, GUINT_TO_POINTER (info->index));
+            return;
+        }
     }
 
     if ((sink_input = paxui_find_sink_input_for_index (paxui, info->index)))
@@ -741,9 +1643,8 @@ sink_input_info_cb (pa_context *c, const pa_sink_input_info *info, int eol, void
     else
     {
         is_new = TRUE;
-        sink_input = paxui_leaf_new (PAXUI_LEAF_TYPE_SINK_INPUT);
+        sink_input = paxui_leaf_new (paxui, PAXUI_LEAF_TYPE_SINK_INPUT);
         sink_input->index = info->index;
-        sink_input->paxui = paxui;
 
         sink_input->module = info->owner_module;
         sink_input->client = info->client;
@@ -752,30 +1653,49 @@ sink_input_info_cb (pa_context *c, const pa_sink_input_info *info, int eol, void
         if (sink_input->vol_enabled)
             copy_volume_chmap (sink_input, &info->volume, &info->channel_map);
 
-        paxui->sink_inputs = g_list_append (paxui->sink_inputs, sink_input);
+        paxui_leaf_register (sink_input);
+
+        if (paxui->lazy_blocks)
+        {
+            if (sink_input->client != G_MAXUINT32)
+                owner_fetch (paxui, PAXUI_LEAF_TYPE_CLIENT, sink_input->client);
+            else
+                owner_fetch (paxui, PAXUI_LEAF_TYPE_MODULE, sink_input->module);
+        }
     }
 
-    sink_input->sink = info->sink;
+    /* a reply sent before a move still in flight has the old sink */
+    if (sink_input->sink != info->sink && sink_input->moves_pending == 0)
+    {
+        paxui_stream_unlink (sink_input);
+        sink_input->sink = info->sink;
+        moved = TRUE;
+    }
+    paxui_stream_link (sink_input);
 
     leaf_get_strings (sink_input, info->name);
 
     if (sink_input->vol_enabled)
     {
         update_volume (sink_input, &info->volume);
-        sink_input->muted = !!info->mute;
+        update_mute (sink_input, info->mute);
     }
 
+    /* widgets are built in one go once the initial lists are in */
+    if (paxui->loading) return;
+
     if (sink_input->client != G_MAXUINT32)
     {
         PaxuiLeaf *cl;
 
         cl = paxui_find_client_for_index (paxui, sink_input->client);
-        if (cl && cl->outer == NULL)
+        /* a lazy placeholder gets widgets once its info is in */
+        if (cl && cl->view == NULL && cl->name)
         {
             DBG("    adding gui for client:%u", sink_input->client);
 
             leaf_gui_new (cl);
-            paxui_gui_trigger_update (paxui);
+            paxui_gui_touch_leaf (cl);
         }
     }
     else if (sink_input->module != G_MAXUINT32)
@@ -783,23 +1703,24 @@ sink_input_info_cb (pa_context *c, const pa_sink_input_info *info, int eol, void
         PaxuiLeaf *md;
 
         md = paxui_find_module_for_index (paxui, sink_input->module);
-        if (md && md->outer == NULL)
+        if (md && md->view == NULL && md->name)
         {
             DBG("    adding gui for module:%u", sink_input->module);
 
             leaf_gui_new (md);
-            paxui_gui_trigger_update (paxui);
+            paxui_gui_touch_leaf (md);
         }
     }
 
     if (is_new)
     {
         leaf_gui_new (sink_input);
-        paxui_gui_trigger_update (paxui);
+        paxui_gui_touch_leaf (sink_input);
     }
     else
     {
         leaf_gui_update (sink_input);
+        if (moved) paxui_gui_touch_leaf (sink_input);
     }
 }
 
@@ -811,7 +1732,30 @@ sink_info_cb (pa_context *c, const pa_sink_info *info, int eol, void *udata)
     PaxuiLeaf *sink;
     gboolean is_new = FALSE;
 
-    if (eol > 0 || info == NULL) return;
+    if (c && eol < 0) op_info_failed (paxui, c);
+
+    if (c && paxui->pa_tml)
+    {
+        PaxuiDelta *d = delta_new (c, PAXUI_DELTA_SINK, eol);
+
+        if (eol == 0 && info)
+        {
+            d->index = info->index;
+            d->owner_module = info->owner_module;
+            d->device = info->monitor_source;
+            d->name = g_strdup (info->name);
+            d->text = g_strdup (info->description);
+            delta_set_volume (d, &info->volume, &info->channel_map, info->mute);
+        }
+        delta_push (paxui, d);
+        return;
+    }
+
+    if (eol > 0 || info == NULL)
+    {
+        initial_list_end (paxui, eol);
+        return;
+    }
 
     DBG("sink info index:%u '%s' '%s'", info->index, info->name, info->description);
 
@@ -822,9 +1766,8 @@ sink_info_cb (pa_context *c, const pa_sink_info *info, int eol, void *udata)
     else
     {
         is_new = TRUE;
-        sink = paxui_leaf_new (PAXUI_LEAF_TYPE_SINK);
+        sink = paxui_leaf_new (paxui, PAXUI_LEAF_TYPE_SINK);
         sink->index = info->index;
-        sink->paxui = paxui;
 
         sink->module = info->owner_module;
         sink->monitor = info->monitor_source;
@@ -835,148 +1778,380 @@ sink_info_cb (pa_context *c, const pa_sink_info *info, int eol, void *udata)
         if (sink->vol_enabled)
             copy_volume_chmap (sink, &info->volume, &info->channel_map);
 
-        paxui->sinks = g_list_append (paxui->sinks, sink);
+        paxui_leaf_register (sink);
     }
 
     if (sink->vol_enabled)
     {
         update_volume (sink, &info->volume);
-        sink->muted = !!info->mute;
+        update_mute (sink, info->mute);
     }
 
+    /* widgets are built in one go once the initial lists are in */
+    if (paxui->loading) return;
+
+    /* relayout only if the widget may have changed size */
+    if (is_new || (sink->dirty & PAXUI_DIRTY_NAME))
+        paxui_gui_trigger_update (paxui);
+
     if (is_new)
         leaf_gui_new (sink);
     else
         leaf_gui_update (sink);
-
-    paxui_gui_trigger_update (paxui);
 }
 
 
 static void
 get_clients (Paxui *paxui)
 {
-    pa_operation_unref (
-        pa_context_get_client_info_list (paxui->pa_ctx,
-                                         (pa_client_info_cb_t) client_info_cb,
-                                         paxui));
+    pa_operation *op;
+    PaxuiOp *t;
+
+    pulse_lock (paxui);
+    t = op_new (paxui, PAXUI_OP_INFO_LIST);
+    op = pa_context_get_client_info_list (paxui->pa_ctx, (pa_client_info_cb_t) client_info_cb, paxui);
+    if (op_track (t, op)) pa_operation_unref (op);
+    pulse_unlock (paxui);
 }
 
 static void
 get_modules (Paxui *paxui)
 {
-    pa_operation_unref (
-        pa_context_get_module_info_list (paxui->pa_ctx,
-                                         (pa_module_info_cb_t) module_info_cb,
-                                         paxui));
+    pa_operation *op;
+    PaxuiOp *t;
+
+    pulse_lock (paxui);
+    t = op_new (paxui, PAXUI_OP_INFO_LIST);
+    op = pa_context_get_module_info_list (paxui->pa_ctx, (pa_module_info_cb_t) module_info_cb, paxui);
+    if (op_track (t, op)) pa_operation_unref (op);
+    pulse_unlock (paxui);
 }
 
 static void
 get_source_outputs (Paxui *paxui)
 {
-    pa_operation_unref (
-        pa_context_get_source_output_info_list (paxui->pa_ctx,
-                                       (pa_source_output_info_cb_t) source_output_info_cb,
-                                       paxui));
+    pa_operation *op;
+    PaxuiOp *t;
+
+    pulse_lock (paxui);
+    t = op_new (paxui, PAXUI_OP_INFO_LIST);
+    op = pa_context_get_source_output_info_list (paxui->pa_ctx, (pa_source_output_info_cb_t) source_output_info_cb, paxui);
+    if (op_track (t, op)) pa_operation_unref (op);
+    pulse_unlock (paxui);
 }
 
 static void
 get_sources (Paxui *paxui)
 {
-    pa_operation_unref (
-        pa_context_get_source_info_list (paxui->pa_ctx,
-                                         (pa_source_info_cb_t) source_info_cb,
-                                         paxui));
+    pa_operation *op;
+    PaxuiOp *t;
+
+    pulse_lock (paxui);
+    t = op_new (paxui, PAXUI_OP_INFO_LIST);
+    op = pa_context_get_source_info_list (paxui->pa_ctx, (pa_source_info_cb_t) source_info_cb, paxui);
+    if (op_track (t, op)) pa_operation_unref (op);
+    pulse_unlock (paxui);
 }
 
 static void
 get_sink_inputs (Paxui *paxui)
 {
-    pa_operation_unref (
-        pa_context_get_sink_input_info_list (paxui->pa_ctx,
-                                       (pa_sink_input_info_cb_t) sink_input_info_cb,
-                                       paxui));
+    pa_operation *op;
+    PaxuiOp *t;
+
+    pulse_lock (paxui);
+    t = op_new (paxui, PAXUI_OP_INFO_LIST);
+    op = pa_context_get_sink_input_info_list (paxui->pa_ctx, (pa_sink_input_info_cb_t) sink_input_info_cb, paxui);
+    if (op_track (t, op)) pa_operation_unref (op);
+    pulse_unlock (paxui);
 }
 
 static void
 get_sinks (Paxui *paxui)
 {
-    pa_operation_unref (
-        pa_context_get_sink_info_list (paxui->pa_ctx,
-                                       (pa_sink_info_cb_t) sink_info_cb,
-                                       paxui));
+    pa_operation *op;
+    PaxuiOp *t;
+
+    pulse_lock (paxui);
+    t = op_new (paxui, PAXUI_OP_INFO_LIST);
+    op = pa_context_get_sink_info_list (paxui->pa_ctx, (pa_sink_info_cb_t) sink_info_cb, paxui);
+    if (op_track (t, op)) pa_operation_unref (op);
+    pulse_unlock (paxui);
 }
 
 
-static void
-event_change (pa_context *c, pa_subscription_event_type_t facility, uint32_t idx, Paxui *paxui)
+/* New & change events are not acted on at once: the object is marked
+ * pending and the queue is flushed from an idle callback, sending one
+ * info request per pending object. While a request for an object is in
+ * flight no other is sent; if the object is marked again meanwhile, the
+ * queue is flushed again when the request completes.
+ *
+ * These refreshes are the background class of request: no more than
+ * bg_max are in flight at once, the rest wait pending. User actions -
+ * moves, volume & mute sets, module loads - are the interactive class
+ * and are sent straight away, so the server has at most bg_max info
+ * replies to get through before it reaches them. */
+
+typedef struct _PaxuiInfoRequest
 {
-    DBG("event 'change'  fac:%s  id:%u", event_fac_str (facility), idx);
+    Paxui          *paxui;
+    pa_operation   *op;
+    guint           facility;
+    guint32         index;
+    guint           seq;        /* tells it from a later request at its address */
+} PaxuiInfoRequest;
+
+
+static pa_operation *
+event_request_info (Paxui *paxui, guint facility, uint32_t idx)
+{
+    pa_context *c = paxui->pa_ctx;
 
     switch (facility)
     {
         case PA_SUBSCRIPTION_EVENT_SOURCE:
-            pa_operation_unref (
-                pa_context_get_source_info_by_index (c, idx, source_info_cb, paxui));
-            break;
+            return pa_context_get_source_info_by_index (c, idx, source_info_cb, paxui);
         case PA_SUBSCRIPTION_EVENT_SOURCE_OUTPUT:
-            pa_operation_unref (
-                pa_context_get_source_output_info (c, idx, source_output_info_cb, paxui));
-            break;
+            return pa_context_get_source_output_info (c, idx, source_output_info_cb, paxui);
         case PA_SUBSCRIPTION_EVENT_SINK:
-            pa_operation_unref (
-                pa_context_get_sink_info_by_index (c, idx, sink_info_cb, paxui));
+            return pa_context_get_sink_info_by_index (c, idx, sink_info_cb, paxui);
         case PA_SUBSCRIPTION_EVENT_SINK_INPUT:
-            pa_operation_unref (
-                pa_context_get_sink_input_info (c, idx, sink_input_info_cb, paxui));
-            break;
+            return pa_context_get_sink_input_info (c, idx, sink_input_info_cb, paxui);
         case PA_SUBSCRIPTION_EVENT_CLIENT:
-            pa_operation_unref (
-                pa_context_get_client_info (c, idx, client_info_cb, paxui));
-            break;
+            return pa_context_get_client_info (c, idx, client_info_cb, paxui);
         case PA_SUBSCRIPTION_EVENT_MODULE:
-            pa_operation_unref (
-                pa_context_get_module_info (c, idx, module_info_cb, paxui));
-            break;
+            return pa_context_get_module_info (c, idx, module_info_cb, paxui);
         default:
-            break;
+            return NULL;
     }
 }
 
 static void
-event_new (pa_context *c, pa_subscription_event_type_t facility, uint32_t idx, Paxui *paxui)
+info_request_free (PaxuiInfoRequest *req)
 {
-    DBG("event 'new'     fac:%s  id:%u", event_fac_str (facility), idx);
+    req->paxui->bg_inflight--;
+
+    pulse_lock (req->paxui);
+    op_notify (req->paxui, req->op, NULL, NULL);
+    pa_operation_unref (req->op);
+    pulse_unlock (req->paxui);
+    g_slice_free (PaxuiInfoRequest, req);
+}
+
+static gboolean event_flush (gpointer udata);
+
+static void
+event_schedule_flush (Paxui *paxui)
+{
+    /* events during initial loading wait until the lists are in */
+    if (paxui->loading) return;
+
+    if (paxui->ev_flush_src == 0)
+        paxui->ev_flush_src = g_idle_add (event_flush, paxui);
+}
+
+static gboolean
+event_volume_busy (Paxui *paxui, guint facility, guint32 idx)
+{
+    PaxuiLeaf *leaf;
 
     switch (facility)
     {
         case PA_SUBSCRIPTION_EVENT_SOURCE:
-            pa_operation_unref (
-                pa_context_get_source_info_by_index (c, idx, source_info_cb, paxui));
+            leaf = paxui_find_leaf_for_index (paxui, PAXUI_LEAF_TYPE_SOURCE, idx);
             break;
         case PA_SUBSCRIPTION_EVENT_SOURCE_OUTPUT:
-            pa_operation_unref (
-                pa_context_get_source_output_info (c, idx, source_output_info_cb, paxui));
+            leaf = paxui_find_leaf_for_index (paxui, PAXUI_LEAF_TYPE_SOURCE_OUTPUT, idx);
             break;
         case PA_SUBSCRIPTION_EVENT_SINK:
-            pa_operation_unref (
-                pa_context_get_sink_info_by_index (c, idx, sink_info_cb, paxui));
+            leaf = paxui_find_leaf_for_index (paxui, PAXUI_LEAF_TYPE_SINK, idx);
             break;
         case PA_SUBSCRIPTION_EVENT_SINK_INPUT:
-            pa_operation_unref (
-                pa_context_get_sink_input_info (c, idx, sink_input_info_cb, paxui));
+            leaf = paxui_find_leaf_for_index (paxui, PAXUI_LEAF_TYPE_SINK_INPUT, idx);
             break;
+        default:
+            return FALSE;
+    }
+
+    return leaf && volume_busy (leaf);
+}
+
+static void
+info_request_done (PaxuiInfoRequest *req)
+{
+    Paxui *paxui = req->paxui;
+    gpointer key = GUINT_TO_POINTER (req->index);
+    guint facility = req->facility;
+
+    TRACE("info request done  fac:%s  id:%u", event_fac_str (facility), req->index);
+
+    /* frees req */
+    g_hash_table_remove (paxui->ev_inflight[facility], key);
+
+    if (paxui->bg_held || g_hash_table_contains (paxui->ev_pending[facility], key))
+        event_schedule_flush (paxui);
+}
+
+static void
+info_request_state_cb (pa_operation *op, void *udata)
+{
+    PaxuiInfoRequest *req = udata;
+    PaxuiDelta *d;
+
+    if (pa_operation_get_state (op) == PA_OPERATION_RUNNING) return;
+
+    if (req->paxui->pa_tml == NULL)
+    {
+        info_request_done (req);
+        return;
+    }
+
+    d = delta_new (NULL, PAXUI_DELTA_REQUEST_DONE, 0);
+    d->index = req->index;
+    d->event = req->facility;
+    d->seq = req->seq;
+    delta_push (req->paxui, d);
+}
+
+static gboolean
+event_flush (gpointer udata)
+{
+    Paxui *paxui = udata;
+    GHashTableIter iter;
+    gpointer key;
+    guint facility, n;
+
+    paxui->ev_flush_src = 0;
+    paxui->bg_held = FALSE;
+
+    pulse_lock (paxui);
+
+    /* facilities take turns, starting after the last one served, so a
+     * storm on one does not hold the others back under bg_max */
+    for (n = 0; n < PAXUI_NUM_FACILITIES; n++)
+    {
+        facility = (paxui->ev_cursor + n) % PAXUI_NUM_FACILITIES;
+
+        g_hash_table_iter_init (&iter, paxui->ev_pending[facility]);
+        while (g_hash_table_iter_next (&iter, &key, NULL))
+        {
+            PaxuiInfoRequest *req;
+            pa_operation *op;
+            PaxuiOp *t;
+
+            /* left pending until the request in flight completes */
+            if (g_hash_table_contains (paxui->ev_inflight[facility], key)) continue;
+
+            /* or until the leaf's own sets are all back, see volume_idle */
+            if (event_volume_busy (paxui, facility, GPOINTER_TO_UINT (key))) continue;
+
+            if (paxui->bg_max && paxui->bg_inflight >= paxui->bg_max)
+            {
+                /* flushed again as requests complete */
+                TRACE("info requests held back, %u in flight", paxui->bg_inflight);
+                paxui->bg_held = TRUE;
+                goto held;
+            }
+
+            g_hash_table_iter_remove (&iter);
+
+            t = op_new (paxui, PAXUI_OP_INFO);
+            op = op_track (t, event_request_info (paxui, facility, GPOINTER_TO_UINT (key)));
+            if (op == NULL) continue;
+
+            req = g_slice_new (PaxuiInfoRequest);
+            req->paxui = paxui;
+            req->op = op;
+            req->facility = facility;
+            req->index = GPOINTER_TO_UINT (key);
+            req->seq = ++paxui->ev_seq;
+
+            g_hash_table_insert (paxui->ev_inflight[facility], key, req);
+            paxui->bg_inflight++;
+            paxui->ev_cursor = (facility + 1) % PAXUI_NUM_FACILITIES;
+            op_notify (paxui, op, info_request_state_cb, req);
+        }
+    }
+held:
+    pulse_unlock (paxui);
+
+    return G_SOURCE_REMOVE;
+}
+
+static void
+event_queue (pa_subscription_event_type_t facility, uint32_t idx, Paxui *paxui)
+{
+    switch (facility)
+    {
+        case PA_SUBSCRIPTION_EVENT_SOURCE:
+        case PA_SUBSCRIPTION_EVENT_SOURCE_OUTPUT:
+        case PA_SUBSCRIPTION_EVENT_SINK:
+        case PA_SUBSCRIPTION_EVENT_SINK_INPUT:
         case PA_SUBSCRIPTION_EVENT_CLIENT:
-            pa_operation_unref (
-                pa_context_get_client_info (c, idx, client_info_cb, paxui));
-            break;
         case PA_SUBSCRIPTION_EVENT_MODULE:
-            pa_operation_unref (
-                pa_context_get_module_info (c, idx, module_info_cb, paxui));
             break;
         default:
-            break;
+            return;
+    }
+
+    g_hash_table_add (paxui->ev_pending[facility], GUINT_TO_POINTER (idx));
+    event_schedule_flush (paxui);
+}
+
+static void
+event_queue_clear (Paxui *paxui)
+{
+    guint facility;
+
+    if (paxui->ev_flush_src)
+    {
+        g_source_remove (paxui->ev_flush_src);
+        paxui->ev_flush_src = 0;
+    }
+
+    for (facility = 0; facility < PAXUI_NUM_FACILITIES; facility++)
+    {
+        if (paxui->ev_pending[facility])
+            g_hash_table_remove_all (paxui->ev_pending[facility]);
+        if (paxui->ev_inflight[facility])
+            g_hash_table_remove_all (paxui->ev_inflight[facility]);
+    }
+
+    paxui->bg_held = FALSE;
+
+    if (paxui->owner_waits) g_hash_table_remove_all (paxui->owner_waits);
+    if (paxui->ignored_sis) g_hash_table_remove_all (paxui->ignored_sis);
+}
+
+
+static void
+event_change (pa_context *c, pa_subscription_event_type_t facility, uint32_t idx, Paxui *paxui)
+{
+    DBG("event 'change'  fac:%s  id:%u", event_fac_str (facility), idx);
+
+    /* lazy mode only follows clients a stream has asked for */
+    if (paxui->lazy_blocks && facility == PA_SUBSCRIPTION_EVENT_CLIENT &&
+        paxui_find_client_for_index (paxui, idx) == NULL) return;
+
+    if (facility == PA_SUBSCRIPTION_EVENT_SINK_INPUT &&
+        g_hash_table_contains (paxui->ignored_sis, GUINT_TO_POINTER (idx)))
+    {
+        TRACE("    ignored sink input");
+        return;
     }
+
+    event_queue (facility, idx, paxui);
+}
+
+static void
+event_new (pa_context *c, pa_subscription_event_type_t facility, uint32_t idx, Paxui *paxui)
+{
+    DBG("event 'new'     fac:%s  id:%u", event_fac_str (facility), idx);
+
+    /* a new client is fetched when its first stream shows up */
+    if (paxui->lazy_blocks && facility == PA_SUBSCRIPTION_EVENT_CLIENT) return;
+
+    event_queue (facility, idx, paxui);
 }
 
 static void
@@ -984,6 +2159,9 @@ event_remove (pa_context *c, pa_subscription_event_type_t facility, uint32_t idx
 {
     DBG("event 'remove'  fac:%s  id:%u", event_fac_str (facility), idx);
 
+    /* no info request for objects removed in the same batch */
+    g_hash_table_remove (paxui->ev_pending[facility], GUINT_TO_POINTER (idx));
+
     switch (facility)
     {
         case PA_SUBSCRIPTION_EVENT_SOURCE:
@@ -993,8 +2171,7 @@ event_remove (pa_context *c, pa_subscription_event_type_t facility, uint32_t idx
                 sc = paxui_find_source_for_index (paxui, idx);
                 if (sc)
                 {
-                    paxui->sources = g_list_remove (paxui->sources, sc);
-
+                    paxui_leaf_unregister (sc);
                     paxui_leaf_destroy (sc);
 
                     paxui_gui_trigger_update (paxui);
@@ -1008,7 +2185,7 @@ event_remove (pa_context *c, pa_subscription_event_type_t facility, uint32_t idx
                 sk = paxui_find_sink_for_index (paxui, idx);
                 if (sk)
                 {
-                    paxui->sinks = g_list_remove (paxui->sinks, sk);
+                    paxui_leaf_unregister (sk);
                     paxui_leaf_destroy (sk);
 
                     paxui_gui_trigger_update (paxui);
@@ -1022,10 +2199,11 @@ event_remove (pa_context *c, pa_subscription_event_type_t facility, uint32_t idx
                 so = paxui_find_source_output_for_index (paxui, idx);
                 if (so)
                 {
-                    paxui->source_outputs = g_list_remove (paxui->source_outputs, so);
-                    paxui_leaf_destroy (so);
+                    paxui_gui_touch_leaf (so);
 
-                    paxui_gui_trigger_update (paxui);
+                    paxui_stream_unlink (so);
+                    paxui_leaf_unregister (so);
+                    paxui_leaf_destroy (so);
                 }
             }
             break;
@@ -1033,13 +2211,16 @@ event_remove (pa_context *c, pa_subscription_event_type_t facility, uint32_t idx
             {
                 PaxuiLeaf *si;
 
+                g_hash_table_remove (paxui->ignored_sis, GUINT_TO_POINTER (idx));
+
                 si = paxui_find_sink_input_for_index (paxui, idx);
                 if (si)
                 {
-                    paxui->sink_inputs = g_list_remove (paxui->sink_inputs, si);
-                    paxui_leaf_destroy (si);
+                    paxui_gui_touch_leaf (si);
 
-                    paxui_gui_trigger_update (paxui);
+                    paxui_stream_unlink (si);
+                    paxui_leaf_unregister (si);
+                    paxui_leaf_destroy (si);
                 }
             }
             break;
@@ -1050,8 +2231,7 @@ event_remove (pa_context *c, pa_subscription_event_type_t facility, uint32_t idx
                 cl = paxui_find_client_for_index (paxui, idx);
                 if (cl)
                 {
-                    paxui->acams = g_list_remove (paxui->acams, cl);
-                    paxui->clients = g_list_remove (paxui->clients, cl);
+                    paxui_leaf_unregister (cl);
                     paxui_leaf_destroy (cl);
 
                     paxui_gui_trigger_update (paxui);
@@ -1062,11 +2242,12 @@ event_remove (pa_context *c, pa_subscription_event_type_t facility, uint32_t idx
             {
                 PaxuiLeaf *md;
 
+                g_hash_table_remove (paxui->owner_waits, GUINT_TO_POINTER (idx));
+
                 md = paxui_find_module_for_index (paxui, idx);
                 if (md)
                 {
-                    paxui->acams = g_list_remove (paxui->acams, md);
-                    paxui->modules = g_list_remove (paxui->modules, md);
+                    paxui_leaf_unregister (md);
                     paxui_leaf_destroy (md);
 
                     paxui_gui_trigger_update (paxui);
@@ -1085,6 +2266,16 @@ event_cb (pa_context *c, pa_subscription_event_type_t t, uint32_t idx, Paxui *pa
 
     pa_subscription_event_type_t type = t & PA_SUBSCRIPTION_EVENT_TYPE_MASK;
 
+    if (c && paxui->pa_tml)
+    {
+        PaxuiDelta *d = delta_new (c, PAXUI_DELTA_EVENT, 0);
+
+        d->event = t;
+        d->index = idx;
+        delta_push (paxui, d);
+        return;
+    }
+
     switch (type)
     {
         case PA_SUBSCRIPTION_EVENT_NEW:
@@ -1107,38 +2298,62 @@ event_cb (pa_context *c, pa_subscription_event_type_t t, uint32_t idx, Paxui *pa
 static void
 subscribed_cb (pa_context *c, int success, Paxui *paxui)
 {
+    if (c && paxui->pa_tml)
+    {
+        delta_push (paxui, delta_new (c, PAXUI_DELTA_SUBSCRIBED, success));
+        return;
+    }
+
     DBG("subscribed sx %d", success);
 
-    paxui_gui_rm_spinner (paxui);
+    /* fill the model silently until all lists have ended */
+    paxui->loading = TRUE;
 
-    get_modules (paxui);
+    if (paxui->lazy_blocks)
+    {
+        /* clients & modules come with the streams that refer to them */
+        paxui->lists_pending = 4;
+    }
+    else
+    {
+        paxui->lists_pending = 6;
+        get_modules (paxui);
+        get_clients (paxui);
+    }
     get_sinks (paxui);
     get_sources (paxui);
-    get_clients (paxui);
     get_sink_inputs (paxui);
     get_source_outputs (paxui);
-
-    paxui->pa_init_done = TRUE;
 }
 
 static void
 renew_connection (Paxui *paxui)
 {
+    event_queue_clear (paxui);
+    paxui->loading = FALSE;
+
+    pulse_lock (paxui);
     pa_context_unref (paxui->pa_ctx);
+    pulse_unlock (paxui);
 
     paxui_make_init_strings (paxui);
 
     paxui_unload_data (paxui);
     paxui_gui_add_spinner (paxui);
 
+    pulse_lock (paxui);
     paxui->pa_ctx = pa_context_new (paxui->pa_mlapi, PAXUI_CLIENT_NAME);
+    pulse_unlock (paxui);
     g_idle_add ((GSourceFunc) paxui_pulse_connect_cb, paxui);
 }
 
 static void
-context_state_cb (pa_context *ctx, Paxui *paxui)
+context_state_changed (Paxui *paxui, pa_context_state_t state)
 {
-    switch (pa_context_get_state (ctx))
+    pa_operation *op;
+    PaxuiOp *t;
+
+    switch (state)
     {
         case PA_CONTEXT_UNCONNECTED:
             DBG("PulseAudio context unconnected!");
@@ -1146,21 +2361,24 @@ context_state_cb (pa_context *ctx, Paxui *paxui)
 
         case PA_CONTEXT_READY:
             DBG("context ready");
+            pulse_lock (paxui);
             pa_context_set_subscribe_callback (
-                    ctx, (pa_context_subscribe_cb_t) event_cb, paxui);
-
-            pa_operation_unref (
-                pa_context_subscribe (ctx,
-                                      PA_SUBSCRIPTION_MASK_SINK |
-                                      PA_SUBSCRIPTION_MASK_SOURCE |
-                                      PA_SUBSCRIPTION_MASK_SINK_INPUT |
-                                      PA_SUBSCRIPTION_MASK_SOURCE_OUTPUT |
-                                      PA_SUBSCRIPTION_MASK_MODULE |
-                                      PA_SUBSCRIPTION_MASK_CLIENT |
-                                      PA_SUBSCRIPTION_MASK_SERVER,
-                                      (pa_context_success_cb_t) subscribed_cb,
-                                      paxui)
-                               );
+                    paxui->pa_ctx, (pa_context_subscribe_cb_t) event_cb, paxui);
+
+            t = op_new (paxui, PAXUI_OP_SUBSCRIBE);
+            t->success = (pa_context_success_cb_t) subscribed_cb;
+            t->success_data = paxui;
+            op = pa_context_subscribe (paxui->pa_ctx,
+                                       PA_SUBSCRIPTION_MASK_SINK |
+                                       PA_SUBSCRIPTION_MASK_SOURCE |
+                                       PA_SUBSCRIPTION_MASK_SINK_INPUT |
+                                       PA_SUBSCRIPTION_MASK_SOURCE_OUTPUT |
+                                       PA_SUBSCRIPTION_MASK_MODULE |
+                                       PA_SUBSCRIPTION_MASK_CLIENT |
+                                       PA_SUBSCRIPTION_MASK_SERVER,
+                                       op_success_cb, t);
+            if (op_track (t, op)) pa_operation_unref (op);
+            pulse_unlock (paxui);
             break;
 
         case PA_CONTEXT_FAILED:
@@ -1189,6 +2407,184 @@ context_state_cb (pa_context *ctx, Paxui *paxui)
     }
 }
 
+static void
+context_state_cb (pa_context *ctx, Paxui *paxui)
+{
+    pa_context_state_t state = pa_context_get_state (ctx);
+
+    if (paxui->pa_tml)
+        delta_push (paxui, delta_new (ctx, PAXUI_DELTA_CONTEXT_STATE, state));
+    else
+        context_state_changed (paxui, state);
+}
+
+/* gtk thread: rebuild the reply from a delta & hand it to its callback */
+static void
+delta_apply (Paxui *paxui, PaxuiDelta *d)
+{
+    switch (d->kind)
+    {
+        case PAXUI_DELTA_CLIENT:
+            {
+                pa_client_info info = { 0 };
+
+                info.index = d->index;
+                info.name = d->name;
+                info.owner_module = d->owner_module;
+                client_info_cb (NULL, (d->eol ? NULL : &info), d->eol, paxui);
+            }
+            break;
+        case PAXUI_DELTA_MODULE:
+            {
+                pa_module_info info = { 0 };
+
+                info.index = d->index;
+                info.name = d->name;
+                info.argument = d->text;
+                module_info_cb (NULL, (d->eol ? NULL : &info), d->eol, paxui);
+            }
+            break;
+        case PAXUI_DELTA_SOURCE:
+            {
+                pa_source_info info = { 0 };
+
+                info.index = d->index;
+                info.name = d->name;
+                info.description = d->text;
+                info.owner_module = d->owner_module;
+                info.monitor_of_sink = d->device;
+                info.volume = d->volume;
+                info.channel_map = d->channel_map;
+                info.mute = d->mute;
+                source_info_cb (NULL, (d->eol ? NULL : &info), d->eol, paxui);
+            }
+            break;
+        case PAXUI_DELTA_SINK:
+            {
+                pa_sink_info info = { 0 };
+
+                info.index = d->index;
+                info.name = d->name;
+                info.description = d->text;
+                info.owner_module = d->owner_module;
+                info.monitor_source = d->device;
+                info.volume = d->volume;
+                info.channel_map = d->channel_map;
+                info.mute = d->mute;
+                sink_info_cb (NULL, (d->eol ? NULL : &info), d->eol, paxui);
+            }
+            break;
+        case PAXUI_DELTA_SOURCE_OUTPUT:
+            {
+                pa_source_output_info info = { 0 };
+
+                info.index = d->index;
+                info.name = d->name;
+                info.owner_module = d->owner_module;
+                info.client = d->client;
+                info.source = d->device;
+                info.has_volume = d->has_volume;
+                info.volume_writable = d->volume_writable;
+                info.volume = d->volume;
+                info.channel_map = d->channel_map;
+                info.mute = d->mute;
+                source_output_info_cb (NULL, (d->eol ? NULL : &info), d->eol, paxui);
+            }
+            break;
+        case PAXUI_DELTA_SINK_INPUT:
+            {
+                pa_sink_input_info info = { 0 };
+
+                info.index = d->index;
+                info.name = d->name;
+                info.owner_module = d->owner_module;
+                info.client = d->client;
+                info.sink = d->device;
+                info.has_volume = d->has_volume;
+                info.volume_writable = d->volume_writable;
+                info.volume = d->volume;
+                info.channel_map = d->channel_map;
+                info.mute = d->mute;
+                sink_input_info_cb (NULL, (d->eol ? NULL : &info), d->eol, paxui);
+            }
+            break;
+        case PAXUI_DELTA_EVENT:
+            event_cb (NULL, d->event, d->index, paxui);
+            break;
+        case PAXUI_DELTA_SUBSCRIBED:
+            subscribed_cb (NULL, d->eol, paxui);
+            break;
+        case PAXUI_DELTA_CONTEXT_STATE:
+            context_state_changed (paxui, d->eol);
+            break;
+        case PAXUI_DELTA_REQUEST_DONE:
+            {
+                PaxuiInfoRequest *req;
+
+                /* request may have gone since, with a cleared queue, & a
+                 * new one for the object may have its address */
+                req = g_hash_table_lookup (paxui->ev_inflight[d->event], GUINT_TO_POINTER (d->index));
+                if (req && req->seq == d->seq) info_request_done (req);
+            }
+            break;
+        case PAXUI_DELTA_VOLUME_DONE:
+            {
+                PaxuiLeaf *leaf = paxui_find_leaf_for_index (paxui, d->event, d->index);
+
+                /* a new send may reuse the old operation's address */
+                if (leaf && leaf->vol && leaf->vol->op && leaf->vol->seq == d->seq) volume_op_done (leaf);
+            }
+            break;
+        case PAXUI_DELTA_MUTE_DONE:
+            {
+                PaxuiLeaf *leaf = paxui_find_leaf_for_index (paxui, d->event, d->index);
+
+                if (leaf && leaf->vol && leaf->vol->mute_op && leaf->vol->mute_seq == d->seq) mute_op_done (leaf);
+            }
+            break;
+        case PAXUI_DELTA_MOVE_DONE:
+            move_done (d->data, d->eol, d->text);
+            break;
+    }
+}
+
+static gboolean
+delta_drain (gpointer udata)
+{
+    Paxui *paxui = udata;
+    PaxuiDelta *d, *next, *list = NULL;
+    gpointer head;
+    guint n = 0;
+
+    /* take the whole stack, then reverse it into arrival order */
+    do
+    {
+        head = g_atomic_pointer_get (&paxui->pa_deltas);
+    }
+    while (!g_atomic_pointer_compare_and_exchange (&paxui->pa_deltas, head, NULL));
+
+    for (d = head; d; d = next)
+    {
+        next = d->next;
+        d->next = list;
+        list = d;
+    }
+
+    for (d = list; d; d = next)
+    {
+        next = d->next;
+
+        if (!paxui->terminated && (d->ctx == NULL || d->ctx == paxui->pa_ctx))
+            delta_apply (paxui, d);
+
+        delta_free (d);
+        n++;
+    }
+
+    TRACE("applied %u deltas", n);
+
+    return G_SOURCE_REMOVE;
+}
 static gboolean
 make_connection (Paxui *paxui)
 {
@@ -1196,11 +2592,15 @@ make_connection (Paxui *paxui)
 
     DBG("make_connection");
 
+    pulse_lock (paxui);
     paxui->pa_ctx = pa_context_new (paxui->pa_mlapi, PAXUI_CLIENT_NAME);
     pa_context_set_state_callback (
                 paxui->pa_ctx, (pa_context_notify_cb_t) context_state_cb, paxui);
 
-    if ((err = pa_context_connect (paxui->pa_ctx, NULL, PA_CONTEXT_NOFAIL, NULL)) < 0)
+    err = pa_context_connect (paxui->pa_ctx, NULL, PA_CONTEXT_NOFAIL, NULL);
+    pulse_unlock (paxui);
+
+    if (err < 0)
     {
         DBG("pa connect fail:%d", err);
         g_timeout_add (2000, (GSourceFunc) paxui_pulse_connect_cb, paxui);
@@ -1226,7 +2626,36 @@ paxui_pulse_connect_cb (Paxui *paxui)
 void
 paxui_pulse_start_client (Paxui *paxui)
 {
+    guint i;
+
+    for (i = 0; i < PAXUI_NUM_FACILITIES; i++)
+    {
+        paxui->ev_pending[i]  = g_hash_table_new (g_direct_hash, g_direct_equal);
+        paxui->ev_inflight[i] = g_hash_table_new_full (g_direct_hash, g_direct_equal,
+                                            NULL, (GDestroyNotify) info_request_free);
+    }
+    paxui->owner_waits = g_hash_table_new_full (g_direct_hash, g_direct_equal,
+                                                NULL, (GDestroyNotify) g_array_unref);
+    paxui->ignored_sis = g_hash_table_new (g_direct_hash, g_direct_equal);
+    paxui->op_live = g_hash_table_new_full (g_direct_hash, g_direct_equal,
+                                            NULL, (GDestroyNotify) op_free);
+
     /* create a mainloop & API */
+    if (paxui->threaded_ml)
+    {
+        paxui->pa_tml = pa_threaded_mainloop_new ();
+        if (paxui->pa_tml && pa_threaded_mainloop_start (paxui->pa_tml) == 0)
+        {
+            DBG("pulse on own thread");
+            paxui->pa_mlapi = pa_threaded_mainloop_get_api (paxui->pa_tml);
+            return;
+        }
+
+        ERR("failed to start threaded mainloop, using glib mainloop");
+        if (paxui->pa_tml) pa_threaded_mainloop_free (paxui->pa_tml);
+        paxui->pa_tml = NULL;
+    }
+
     paxui->pa_ml = pa_glib_mainloop_new (NULL);
     paxui->pa_mlapi = pa_glib_mainloop_get_api (paxui->pa_ml);
 }
@@ -1234,16 +2663,53 @@ paxui_pulse_start_client (Paxui *paxui)
 void
 paxui_pulse_stop_client (Paxui *paxui)
 {
+    guint i;
+
     if (paxui->terminated) return;
 
     paxui->terminated = TRUE;
 
+    event_queue_clear (paxui);
+
     if (paxui->pa_ctx)
     {
+        pulse_lock (paxui);
         pa_context_disconnect (paxui->pa_ctx);
         pa_context_unref (paxui->pa_ctx);
-        pa_glib_mainloop_free (paxui->pa_ml);
+        pulse_unlock (paxui);
+
+        if (paxui->pa_tml)
+        {
+            pa_threaded_mainloop_stop (paxui->pa_tml);
+            pa_threaded_mainloop_free (paxui->pa_tml);
+            paxui->pa_tml = NULL;
+
+            /* frees what the pa thread left, applying none of it */
+            delta_drain (paxui);
+        }
+        else
+        {
+            pa_glib_mainloop_free (paxui->pa_ml);
+        }
+    }
+
+    for (i = 0; i < PAXUI_NUM_FACILITIES; i++)
+    {
+        if (paxui->ev_pending[i])  g_hash_table_unref (paxui->ev_pending[i]);
+        if (paxui->ev_inflight[i]) g_hash_table_unref (paxui->ev_inflight[i]);
+        paxui->ev_pending[i]  = NULL;
+        paxui->ev_inflight[i] = NULL;
     }
+
+    if (paxui->owner_waits) g_hash_table_unref (paxui->owner_waits);
+    if (paxui->ignored_sis) g_hash_table_unref (paxui->ignored_sis);
+    paxui->owner_waits = NULL;
+    paxui->ignored_sis = NULL;
+
+    /* all ops were cancelled with the context */
+    paxui_pulse_op_stats_log (paxui);
+    if (paxui->op_live) g_hash_table_unref (paxui->op_live);
+    paxui->op_live = NULL;
 }
 
 
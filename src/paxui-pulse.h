@@ -11,8 +11,13 @@ void        paxui_pulse_load_module         (Paxui *paxui, const gchar *mod_name
 void        paxui_pulse_unload_module       (Paxui *paxui, guint32 index);
 
 void        paxui_pulse_volume_set          (PaxuiLeaf *leaf);
+void        paxui_pulse_volume_flush        (PaxuiLeaf *leaf);
+void        paxui_pulse_volume_cancel       (PaxuiLeaf *leaf);
 void        paxui_pulse_mute_set            (PaxuiLeaf *leaf);
 const gchar *paxui_pulse_channel_str        (guint32 pos);
 
+void        paxui_pulse_op_stats            (Paxui *paxui, guint kind, PaxuiOpStats *stats);
+void        paxui_pulse_op_stats_log        (Paxui *paxui);
+
 
 #endif
@@ -8,6 +8,10 @@
 #include "paxui-gui.h"
 
 
+#define PAXUI_LEAF_SLAB (32)        /* leaves per arena slab */
+#define PAXUI_BG_REQUESTS (8)       /* default cap on info requests in flight */
+
+
 gint debug = 0;
 
 const gchar *image_names[] = {
@@ -140,174 +144,604 @@ unescape_string (gchar *escaped)
 }
 
 
+static GList **
+leaf_type_list (Paxui *paxui, guint leaf_type)
+{
+    switch (leaf_type)
+    {
+        case PAXUI_LEAF_TYPE_MODULE:
+            return &paxui->modules;
+        case PAXUI_LEAF_TYPE_CLIENT:
+            return &paxui->clients;
+        case PAXUI_LEAF_TYPE_SOURCE:
+            return &paxui->sources;
+        case PAXUI_LEAF_TYPE_SINK:
+            return &paxui->sinks;
+        case PAXUI_LEAF_TYPE_SOURCE_OUTPUT:
+            return &paxui->source_outputs;
+        case PAXUI_LEAF_TYPE_SINK_INPUT:
+            return &paxui->sink_inputs;
+        default:
+            return NULL;
+    }
+}
+
+
 PaxuiLeaf *
-paxui_find_module_for_index (const Paxui *paxui, guint32 index)
+paxui_find_leaf_for_index (const Paxui *paxui, guint leaf_type, guint32 index)
 {
-    GList *l;
-    PaxuiLeaf *md;
+    if (leaf_type >= PAXUI_LEAF_NUM_TYPES || paxui->leaf_index[leaf_type] == NULL)
+        return NULL;
 
-    for (l = paxui->modules; l; l = l->next)
-    {
-        md = l->data;
+    return g_hash_table_lookup (paxui->leaf_index[leaf_type], GUINT_TO_POINTER (index));
+}
 
-        if (md->index == index) return md;
-    }
+PaxuiLeaf *
+paxui_find_leaf_for_name (const Paxui *paxui, guint leaf_type, const gchar *name)
+{
+    PaxuiName *pn;
+
+    if (name == NULL ||
+        leaf_type >= PAXUI_LEAF_NUM_TYPES || paxui->leaf_names[leaf_type] == NULL)
+        return NULL;
+
+    /* keyed by interned name, so no leaf has it if it's not interned */
+    if ((pn = paxui_name_lookup (paxui, name)) == NULL) return NULL;
 
-    return NULL;
+    return g_hash_table_lookup (paxui->leaf_names[leaf_type], pn->str);
+}
+
+PaxuiLeaf *
+paxui_find_module_for_index (const Paxui *paxui, guint32 index)
+{
+    return paxui_find_leaf_for_index (paxui, PAXUI_LEAF_TYPE_MODULE, index);
 }
 
 PaxuiLeaf *
 paxui_find_client_for_index (const Paxui *paxui, guint32 index)
 {
-    GList *l;
-    PaxuiLeaf *cl;
+    return paxui_find_leaf_for_index (paxui, PAXUI_LEAF_TYPE_CLIENT, index);
+}
+
+PaxuiLeaf *
+paxui_find_source_output_for_index (const Paxui *paxui, guint32 index)
+{
+    return paxui_find_leaf_for_index (paxui, PAXUI_LEAF_TYPE_SOURCE_OUTPUT, index);
+}
+
+PaxuiLeaf *
+paxui_find_sink_input_for_index (const Paxui *paxui, guint32 index)
+{
+    return paxui_find_leaf_for_index (paxui, PAXUI_LEAF_TYPE_SINK_INPUT, index);
+}
+
+PaxuiLeaf *
+paxui_find_source_for_index (const Paxui *paxui, guint32 index)
+{
+    return paxui_find_leaf_for_index (paxui, PAXUI_LEAF_TYPE_SOURCE, index);
+}
+
+PaxuiLeaf *
+paxui_find_sink_for_index (const Paxui *paxui, guint32 index)
+{
+    return paxui_find_leaf_for_index (paxui, PAXUI_LEAF_TYPE_SINK, index);
+}
+
+
+/* First strips whitespace from the ends of long_name.
+ * Then, if long_name contains more than n words, return n words
+ * with the addition of ellipsis character in utf-8;
+ * otherwise returns a copy of stripped long_name */
+static gchar *
+make_short_name (gchar *long_name, gint n)
+{
+    gchar *short_name, *p, *s;
+    gboolean in_word;
+
+    if (long_name == NULL || n < 1) return NULL;
+
+    g_strstrip (long_name);
+
+    for (p = long_name, s = p, in_word = TRUE; *p; p++)
+    {
+        if (g_ascii_isspace (*p))
+        {
+            if (in_word)
+            {
+                s = p;
+                n--;
+                if (n == 0) break;
+                in_word = FALSE;
+            }
+        }
+        else
+        {
+            in_word = TRUE;
+        }
+    }
+    if (*p == '\0')
+    {
+        short_name = g_malloc (p - long_name + 1);
+        strcpy (short_name, long_name);
+    }
+    else
+    {
+        short_name = g_malloc (s - long_name + 4);
+        strncpy (short_name, long_name, s - long_name);
+        strcpy (short_name + (s - long_name), PAXUI_UTF8_ELLIPSIS);
+    }
+
+    return short_name;
+}
+
+static gchar *
+make_utf8_name (const gchar *name)
+{
+    static const gchar *charset = NULL;
+    static gboolean is_utf8;
+    gchar *utf8;
+
+    if (charset == NULL)
+    {
+        is_utf8 = g_get_charset (&charset);
 
-    for (l = paxui->clients; l; l = l->next)
+        DBG("encoding is '%s'", charset);
+    }
+
+    if (is_utf8)
     {
-        cl = l->data;
 
-        if (cl->index == index) return cl;
+        return g_utf8_make_valid (name, -1);
     }
 
-    return NULL;
+    utf8 = g_locale_to_utf8 (name, -1, NULL, NULL, NULL);
+
+    return (utf8 ? utf8 : g_utf8_make_valid (name, -1));
 }
 
-PaxuiLeaf *
-paxui_find_source_output_for_index (const Paxui *paxui, guint32 index)
+/* pa names are interned: each distinct name is stored once, with its
+ * display forms made on first use, and leaves hold references */
+PaxuiName *
+paxui_name_lookup (const Paxui *paxui, const gchar *str)
 {
-    GList *l;
-    PaxuiLeaf *so;
+    if (str == NULL || paxui->names == NULL) return NULL;
+
+    return g_hash_table_lookup (paxui->names, str);
+}
+
+PaxuiName *
+paxui_name_intern (Paxui *paxui, const gchar *str)
+{
+    PaxuiName *pn;
 
-    for (l = paxui->source_outputs; l; l = l->next)
+    if (str == NULL) return NULL;
+
+    if ((pn = g_hash_table_lookup (paxui->names, str)))
+    {
+        pn->ref_count++;
+        return pn;
+    }
+
+    pn = g_slice_new0 (PaxuiName);
+    pn->str = g_strdup (str);
+    pn->ref_count = 1;
+    g_hash_table_insert (paxui->names, pn->str, pn);
+
+    return pn;
+}
+
+static void
+name_free (PaxuiName *pn)
+{
+    g_free (pn->str);
+    g_free (pn->utf8);
+    g_free (pn->short_str);
+    g_slice_free (PaxuiName, pn);
+}
+
+void
+paxui_name_release (Paxui *paxui, PaxuiName *pn)
+{
+    if (pn == NULL || --pn->ref_count > 0) return;
+
+    g_hash_table_remove (paxui->names, pn->str);
+    name_free (pn);
+}
+
+/* drop every name at once, for when all leaves go together */
+static void
+names_clear (Paxui *paxui)
+{
+    GHashTableIter iter;
+    PaxuiName *pn;
+
+    g_hash_table_iter_init (&iter, paxui->names);
+    while (g_hash_table_iter_next (&iter, NULL, (gpointer *) &pn))
+        name_free (pn);
+
+    g_hash_table_remove_all (paxui->names);
+}
+
+const gchar *
+paxui_name_utf8 (PaxuiName *pn)
+{
+    if (pn->utf8 == NULL) pn->utf8 = make_utf8_name (pn->str);
+
+    return pn->utf8;
+}
+
+/* first three words of utf8 form */
+const gchar *
+paxui_name_short (PaxuiName *pn)
+{
+    if (pn->short_str == NULL)
     {
-        so = l->data;
+        gchar *tmp = g_strdup (paxui_name_utf8 (pn));
 
-        if (so->index == index) return so;
+        pn->short_str = make_short_name (tmp, 3);
+        g_free (tmp);
     }
 
-    return NULL;
+    return pn->short_str;
 }
 
-PaxuiLeaf *
-paxui_find_sink_input_for_index (const Paxui *paxui, guint32 index)
+
+static void
+leaf_name_index (PaxuiLeaf *leaf)
 {
-    GList *l;
-    PaxuiLeaf *si;
+    if (leaf->name == NULL || leaf->link == NULL) return;
+
+    /* keyed by interned name pointer */
+    g_hash_table_replace (leaf->paxui->leaf_names[leaf->leaf_type], leaf->pname->str, leaf);
+}
+
+static void
+leaf_name_unindex (PaxuiLeaf *leaf)
+{
+    GHashTable *names;
 
-    for (l = paxui->sink_inputs; l; l = l->next)
+    if (leaf->name == NULL || leaf->link == NULL) return;
+
+    /* a duplicate name may since have been indexed to another leaf */
+    names = leaf->paxui->leaf_names[leaf->leaf_type];
+    if (g_hash_table_lookup (names, leaf->name) == leaf)
+        g_hash_table_remove (names, leaf->name);
+}
+
+/* add leaf to its type list & registry; leaf->paxui must be set */
+void
+paxui_leaf_register (PaxuiLeaf *leaf)
+{
+    Paxui *paxui = leaf->paxui;
+    GList **list, **tail, *link;
+
+    if (leaf->link || (list = leaf_type_list (paxui, leaf->leaf_type)) == NULL) return;
+
+    /* appended, so lists keep server order */
+    tail = &paxui->list_tail[leaf->leaf_type];
+    if (*tail == NULL) *tail = g_list_last (*list);
+
+    link = g_list_alloc ();
+    link->data = leaf;
+    link->prev = *tail;
+    if (*tail)
+        (*tail)->next = link;
+    else
+        *list = link;
+    *tail = link;
+    leaf->link = link;
+
+    g_hash_table_insert (paxui->leaf_index[leaf->leaf_type],
+                         GUINT_TO_POINTER (leaf->index), leaf);
+    leaf_name_index (leaf);
+}
+
+/* remove leaf from registry, its type list & acams; does not free it */
+void
+paxui_leaf_unregister (PaxuiLeaf *leaf)
+{
+    Paxui *paxui = leaf->paxui;
+    GList **list;
+
+    if (leaf->link == NULL || (list = leaf_type_list (paxui, leaf->leaf_type)) == NULL) return;
+
+    leaf_name_unindex (leaf);
+    if (g_hash_table_lookup (paxui->leaf_index[leaf->leaf_type],
+                             GUINT_TO_POINTER (leaf->index)) == leaf)
     {
-        si = l->data;
+        g_hash_table_remove (paxui->leaf_index[leaf->leaf_type],
+                             GUINT_TO_POINTER (leaf->index));
+    }
+
+    if (paxui->list_tail[leaf->leaf_type] == leaf->link)
+        paxui->list_tail[leaf->leaf_type] = leaf->link->prev;
+    *list = g_list_delete_link (*list, leaf->link);
+    leaf->link = NULL;
 
-        if (si->index == index) return si;
+    if (leaf->acam_link)
+    {
+        paxui->acams = g_list_delete_link (paxui->acams, leaf->acam_link);
+        leaf->acam_link = NULL;
     }
+}
+
+void
+paxui_leaf_set_name (PaxuiLeaf *leaf, const gchar *name)
+{
+    PaxuiName *pn;
+
+    if (leaf->name && name && strcmp (leaf->name, name) == 0) return;
+
+    leaf_name_unindex (leaf);
+
+    pn = paxui_name_intern (leaf->paxui, name);
+    paxui_name_release (leaf->paxui, leaf->pname);
+    leaf->pname = pn;
+
+    leaf->name = (pn ? pn->str : NULL);
+    leaf->utf8_name = (pn ? paxui_name_utf8 (pn) : NULL);
 
-    return NULL;
+    leaf_name_index (leaf);
 }
 
-PaxuiLeaf *
-paxui_find_source_for_index (const Paxui *paxui, guint32 index)
+/* short label: given string, or NULL for short form of leaf name */
+void
+paxui_leaf_set_short_name (PaxuiLeaf *leaf, const gchar *short_name)
 {
-    GList *l;
-    PaxuiLeaf *sc;
+    PaxuiName *pn = NULL;
 
-    for (l = paxui->sources; l; l = l->next)
+    if (short_name) pn = paxui_name_intern (leaf->paxui, short_name);
+
+    paxui_name_release (leaf->paxui, leaf->pshort);
+    leaf->pshort = pn;
+
+    if (pn)
+        leaf->short_name = pn->str;
+    else
+        leaf->short_name = (leaf->pname ? paxui_name_short (leaf->pname) : NULL);
+}
+
+static void
+leaf_registry_new (Paxui *paxui)
+{
+    gint i;
+
+    paxui->names = g_hash_table_new (g_str_hash, g_str_equal);
+    paxui->owned = g_hash_table_new (g_direct_hash, g_direct_equal);
+
+    for (i = 0; i < PAXUI_LEAF_NUM_TYPES; i++)
     {
-        sc = l->data;
+        paxui->leaf_index[i] = g_hash_table_new (g_direct_hash, g_direct_equal);
+        paxui->leaf_names[i] = g_hash_table_new (g_direct_hash, g_direct_equal);
+        paxui->adjacency[i]  = g_hash_table_new_full (g_direct_hash, g_direct_equal,
+                                                      NULL, (GDestroyNotify) g_hash_table_unref);
+    }
+}
 
-        if (sc->index == index) return sc;
+static void
+leaf_registry_free (Paxui *paxui)
+{
+    gint i;
+
+    if (paxui->names) g_hash_table_unref (paxui->names);
+    if (paxui->owned) g_hash_table_unref (paxui->owned);
+    paxui->names = NULL;
+    paxui->owned = NULL;
+
+    for (i = 0; i < PAXUI_LEAF_NUM_TYPES; i++)
+    {
+        if (paxui->leaf_index[i]) g_hash_table_unref (paxui->leaf_index[i]);
+        if (paxui->leaf_names[i]) g_hash_table_unref (paxui->leaf_names[i]);
+        if (paxui->adjacency[i])  g_hash_table_unref (paxui->adjacency[i]);
+        if (paxui->touched[i])    g_hash_table_unref (paxui->touched[i]);
+        paxui->leaf_index[i] = NULL;
+        paxui->leaf_names[i] = NULL;
+        paxui->adjacency[i]  = NULL;
+        paxui->touched[i]    = NULL;
+    }
+}
+
+
+static void
+adjacency_add (Paxui *paxui, guint leaf_type, guint32 index, PaxuiLeaf *stream)
+{
+    GHashTable *set;
+
+    if (index == G_MAXUINT32) return;
+
+    set = g_hash_table_lookup (paxui->adjacency[leaf_type], GUINT_TO_POINTER (index));
+    if (set == NULL)
+    {
+        set = g_hash_table_new (g_direct_hash, g_direct_equal);
+        g_hash_table_insert (paxui->adjacency[leaf_type], GUINT_TO_POINTER (index), set);
     }
 
-    return NULL;
+    g_hash_table_add (set, stream);
 }
 
-PaxuiLeaf *
-paxui_find_sink_for_index (const Paxui *paxui, guint32 index)
+static void
+adjacency_remove (Paxui *paxui, guint leaf_type, guint32 index, PaxuiLeaf *stream)
 {
-    GList *l;
-    PaxuiLeaf *sk;
+    GHashTable *set;
 
-    for (l = paxui->sinks; l; l = l->next)
+    if (index == G_MAXUINT32) return;
+
+    set = g_hash_table_lookup (paxui->adjacency[leaf_type], GUINT_TO_POINTER (index));
+    if (set == NULL) return;
+
+    g_hash_table_remove (set, stream);
+    if (g_hash_table_size (set) == 0)
+        g_hash_table_remove (paxui->adjacency[leaf_type], GUINT_TO_POINTER (index));
+}
+
+/* Add so/si to the stream sets of its client, module & source/sink.
+ * Sets are keyed by pa index, so the owner need not be known yet. */
+void
+paxui_stream_link (PaxuiLeaf *stream)
+{
+    Paxui *paxui = stream->paxui;
+
+    if (stream->linked) return;
+
+    switch (stream->leaf_type)
     {
-        sk = l->data;
+        case PAXUI_LEAF_TYPE_SOURCE_OUTPUT:
+            adjacency_add (paxui, PAXUI_LEAF_TYPE_SOURCE, stream->source, stream);
+            break;
+        case PAXUI_LEAF_TYPE_SINK_INPUT:
+            adjacency_add (paxui, PAXUI_LEAF_TYPE_SINK, stream->sink, stream);
+            break;
+        default:
+            return;
+    }
+    adjacency_add (paxui, PAXUI_LEAF_TYPE_CLIENT, stream->client, stream);
+    adjacency_add (paxui, PAXUI_LEAF_TYPE_MODULE, stream->module, stream);
+
+    stream->linked = TRUE;
+}
 
-        if (sk->index == index) return sk;
+/* must be called before changing the stream's client, module or device */
+void
+paxui_stream_unlink (PaxuiLeaf *stream)
+{
+    Paxui *paxui = stream->paxui;
+
+    if (!stream->linked) return;
+
+    switch (stream->leaf_type)
+    {
+        case PAXUI_LEAF_TYPE_SOURCE_OUTPUT:
+            adjacency_remove (paxui, PAXUI_LEAF_TYPE_SOURCE, stream->source, stream);
+            break;
+        case PAXUI_LEAF_TYPE_SINK_INPUT:
+            adjacency_remove (paxui, PAXUI_LEAF_TYPE_SINK, stream->sink, stream);
+            break;
     }
+    adjacency_remove (paxui, PAXUI_LEAF_TYPE_CLIENT, stream->client, stream);
+    adjacency_remove (paxui, PAXUI_LEAF_TYPE_MODULE, stream->module, stream);
+
+    stream->linked = FALSE;
+}
+
+/* set of so/si attached to a client, module, source or sink; NULL if none */
+GHashTable *
+paxui_streams_for_leaf (const PaxuiLeaf *leaf)
+{
+    if (leaf->paxui == NULL || leaf->paxui->adjacency[leaf->leaf_type] == NULL)
+        return NULL;
 
-    return NULL;
+    return g_hash_table_lookup (leaf->paxui->adjacency[leaf->leaf_type],
+                                GUINT_TO_POINTER (leaf->index));
 }
 
 
 void
 paxui_block_update_active (PaxuiLeaf *block, Paxui *paxui)
 {
-    GList *l;
-
     switch (block->leaf_type)
     {
         case PAXUI_LEAF_TYPE_CLIENT:
-            for (l = paxui->sink_inputs; l; l = l->next)
-            {
-                PaxuiLeaf *si = l->data;
+        case PAXUI_LEAF_TYPE_MODULE:
+            block->active = (paxui_streams_for_leaf (block) != NULL);
+            return;
+    }
+    block->active = FALSE;
+}
 
-                if (si->client == block->index)
-                {
-                    block->active = TRUE;
-                    return;
-                }
-            }
-            for (l = paxui->source_outputs; l; l = l->next)
-            {
-                PaxuiLeaf *so = l->data;
 
-                if (so->client == block->index)
-                {
-                    block->active = TRUE;
-                    return;
-                }
-            }
-            break;
-        case PAXUI_LEAF_TYPE_MODULE:
-            for (l = paxui->sink_inputs; l; l = l->next)
-            {
-                PaxuiLeaf *si = l->data;
+/* hand back every slot at once; slabs are kept for the next load */
+static void
+leaf_arena_reset (Paxui *paxui)
+{
+    paxui->slab_cur = 0;
+    paxui->slab_used = 0;
+    paxui->leaf_free = NULL;
+}
 
-                if (si->module == block->index)
-                {
-                    block->active = TRUE;
-                    return;
-                }
-            }
-            for (l = paxui->source_outputs; l; l = l->next)
-            {
-                PaxuiLeaf *so = l->data;
+static void
+leaf_arena_free (Paxui *paxui)
+{
+    if (paxui->leaf_slabs) g_ptr_array_free (paxui->leaf_slabs, TRUE);
+    paxui->leaf_slabs = NULL;
+    leaf_arena_reset (paxui);
+}
 
-                if (so->module == block->index)
-                {
-                    block->active = TRUE;
-                    return;
-                }
-            }
-            break;
+static PaxuiLeaf *
+leaf_arena_alloc (Paxui *paxui)
+{
+    PaxuiLeaf *leaf;
+
+    if ((leaf = paxui->leaf_free))
+    {
+        paxui->leaf_free = leaf->next_free;
+        return leaf;
     }
-    block->active = FALSE;
+
+    if (paxui->leaf_slabs == NULL)
+        paxui->leaf_slabs = g_ptr_array_new_with_free_func (g_free);
+
+    if (paxui->slab_cur < paxui->leaf_slabs->len && paxui->slab_used == PAXUI_LEAF_SLAB)
+    {
+        paxui->slab_cur++;
+        paxui->slab_used = 0;
+    }
+    if (paxui->slab_cur == paxui->leaf_slabs->len)
+    {
+        g_ptr_array_add (paxui->leaf_slabs, g_new (PaxuiLeaf, PAXUI_LEAF_SLAB));
+        paxui->slab_used = 0;
+    }
+
+    leaf = g_ptr_array_index (paxui->leaf_slabs, paxui->slab_cur);
+    return leaf + paxui->slab_used++;
+}
+
+
+/* keep leaf in the set of those holding widgets or volume state */
+void
+paxui_leaf_update_owned (PaxuiLeaf *leaf)
+{
+    if (leaf->view || leaf->vol)
+        g_hash_table_add (leaf->paxui->owned, leaf);
+    else
+        g_hash_table_remove (leaf->paxui->owned, leaf);
+}
+
+/* drop widgets & volume state, the part of a leaf unload has to visit */
+static void
+leaf_release_owned (PaxuiLeaf *leaf)
+{
+    leaf_gui_destroy (leaf);
+    paxui_pulse_volume_cancel (leaf);
+
+    if (leaf->vol)
+    {
+        g_slice_free (PaxuiVolume, leaf->vol);
+        leaf->vol = NULL;
+    }
+    paxui_leaf_update_owned (leaf);
 }
 
+/* drop what a leaf holds outside the arena */
+static void
+leaf_release (PaxuiLeaf *leaf)
+{
+    leaf_release_owned (leaf);
+    paxui_name_release (leaf->paxui, leaf->pname);
+    paxui_name_release (leaf->paxui, leaf->pshort);
+    paxui_gui_colour_free (leaf->paxui, leaf->colour);
+}
 
 void
 paxui_leaf_destroy (PaxuiLeaf *leaf)
 {
+    Paxui *paxui = leaf->paxui;
+
     TRACE("leaf destroy");
 
-    if (GTK_IS_WIDGET (leaf->outer)) gtk_widget_destroy (leaf->outer);
-    g_free (leaf->name);
-    g_free (leaf->short_name);
-    g_free (leaf->utf8_name);
-    g_free (leaf->levels);
-    g_free (leaf->positions);
-    g_free (leaf->sliders);
-    paxui_gui_colour_free (leaf->paxui, leaf->colour);
+    leaf_release (leaf);
 
-    g_free (leaf);
+    leaf->next_free = paxui->leaf_free;
+    paxui->leaf_free = leaf;
 }
 
 static void
@@ -341,6 +775,9 @@ paxui_destroy (Paxui *paxui)
 
     TRACE("paxui destroy");
 
+    DBG("gui updates:%u skipped:%u, name rebuilds skipped:%u",
+        paxui->gui_updates, paxui->gui_skips, paxui->name_skips);
+
     paxui_unload_init_strings (paxui);
 
     for (i = 0; i < PX_NUM_ICONS; i++)
@@ -348,7 +785,21 @@ paxui_destroy (Paxui *paxui)
         if (paxui->icons[i]) g_object_unref (paxui->icons[i]);
     }
 
+    paxui_gui_free_pools (paxui);
+    leaf_registry_free (paxui);
+    leaf_arena_free (paxui);
+
+    for (i = 0; i < PAXUI_GRID_COLS; i++)
+    {
+        if (paxui->grid_used[i]) g_array_free (paxui->grid_used[i], TRUE);
+    }
+
     if (paxui->size_group) g_object_unref (paxui->size_group);
+    if (paxui->edge_layer) cairo_surface_destroy (paxui->edge_layer);
+    if (paxui->edge_damage) cairo_region_destroy (paxui->edge_damage);
+    if (paxui->edges)      g_array_free (paxui->edges, TRUE);
+    if (paxui->edge_rows)  g_array_free (paxui->edge_rows, TRUE);
+    if (paxui->edge_row_start) g_array_free (paxui->edge_row_start, TRUE);
     if (paxui->name_regex)  g_regex_unref  (paxui->name_regex);
 
     g_free (paxui->colours);
@@ -362,29 +813,54 @@ paxui_destroy (Paxui *paxui)
 void
 paxui_unload_data (Paxui *paxui)
 {
+    GList *lists[] = { paxui->modules, paxui->clients, paxui->source_outputs,
+                       paxui->sink_inputs, paxui->sources, paxui->sinks };
+    GList *owned, *li;
+    gint i;
+
+    for (i = 0; i < PAXUI_LEAF_NUM_TYPES; i++)
+    {
+        if (paxui->leaf_index[i]) g_hash_table_remove_all (paxui->leaf_index[i]);
+        if (paxui->leaf_names[i]) g_hash_table_remove_all (paxui->leaf_names[i]);
+        if (paxui->adjacency[i])  g_hash_table_remove_all (paxui->adjacency[i]);
+    }
+
+    /* only leaves with widgets or volume state are visited; names &
+     * colour counts are dropped whole & the leaves go with the arena */
+    owned = g_hash_table_get_keys (paxui->owned);
+    for (li = owned; li; li = li->next)
+        leaf_release_owned (li->data);
+    g_list_free (owned);
+
+    names_clear (paxui);
+    if (paxui->col_num) memset (paxui->col_num, 0, paxui->num_colours * sizeof (guint));
+
+    for (i = 0; i < (gint) G_N_ELEMENTS (lists); i++)
+        g_list_free (lists[i]);
+    leaf_arena_reset (paxui);
+
+    for (i = 0; i < PAXUI_LEAF_NUM_TYPES; i++)
+        paxui->list_tail[i] = NULL;
+
     g_list_free (paxui->acams);
     paxui->acams = NULL;
-    g_list_free_full (paxui->modules, (GDestroyNotify) paxui_leaf_destroy);
     paxui->modules = NULL;
-    g_list_free_full (paxui->clients, (GDestroyNotify) paxui_leaf_destroy);
     paxui->clients = NULL;
-    g_list_free_full (paxui->source_outputs, (GDestroyNotify) paxui_leaf_destroy);
     paxui->source_outputs = NULL;
-    g_list_free_full (paxui->sink_inputs, (GDestroyNotify) paxui_leaf_destroy);
     paxui->sink_inputs = NULL;
-    g_list_free_full (paxui->sources, (GDestroyNotify) paxui_leaf_destroy);
     paxui->sources = NULL;
-    g_list_free_full (paxui->sinks, (GDestroyNotify) paxui_leaf_destroy);
     paxui->sinks = NULL;
 }
 
 
 PaxuiLeaf *
-paxui_leaf_new (guint leaf_type)
+paxui_leaf_new (Paxui *paxui, guint leaf_type)
 {
     PaxuiLeaf *leaf;
 
-    leaf = g_new0 (PaxuiLeaf, 1);
+    leaf = leaf_arena_alloc (paxui);
+    memset (leaf, 0, sizeof (PaxuiLeaf));
+    leaf->paxui = paxui;
     leaf->leaf_type = leaf_type;
 
     leaf->module  = G_MAXUINT32;
@@ -529,6 +1005,7 @@ paxui_make_init_strings (Paxui *paxui)
     TRACE("make init strings");
 
     paxui->sources = g_list_sort (paxui->sources, paxui_cmp_blocks_y);
+    paxui->list_tail[PAXUI_LEAF_TYPE_SOURCE] = NULL;
     for (l = paxui->sources; l; l = l->next)
     {
         leaf = l->data;
@@ -553,6 +1030,7 @@ paxui_make_init_strings (Paxui *paxui)
     }
 
     paxui->sinks = g_list_sort (paxui->sinks, paxui_cmp_blocks_y);
+    paxui->list_tail[PAXUI_LEAF_TYPE_SINK] = NULL;
     for (l = paxui->sinks; l; l = l->next)
     {
         leaf = l->data;
@@ -686,6 +1164,22 @@ parse_boolean_setting (const gchar *conf_key,
     return FALSE;
 }
 
+static gboolean
+parse_uint_setting (const gchar *conf_key,
+                    const gchar *key, const gchar *value,
+                    guint *ret_val)
+{
+    gchar *end;
+    guint64 v;
+
+    if (strcmp (key, conf_key)) return FALSE;
+
+    v = g_ascii_strtoull (value, &end, 10);
+    if (*end == '\0' && v <= G_MAXUINT) *ret_val = v;
+
+    return TRUE;
+}
+
 void
 paxui_load_conf (Paxui *paxui)
 {
@@ -742,6 +1236,12 @@ paxui_load_conf (Paxui *paxui)
                     continue;
                 else if (parse_boolean_setting ("VolumeControlsDisabled", *cline, p, &paxui->volume_disabled))
                     continue;
+                else if (parse_boolean_setting ("LazyBlocks", *cline, p, &paxui->lazy_blocks))
+                    continue;
+                else if (parse_boolean_setting ("ThreadedMainloop", *cline, p, &paxui->threaded_ml))
+                    continue;
+                else if (parse_uint_setting ("MaxBackgroundRequests", *cline, p, &paxui->bg_max))
+                    continue;
                 else if (parse_boolean_setting ("ThisIsSpinalTap", *cline, p, &paxui->tist_enabled))
                     continue;
                 else
@@ -828,6 +1328,8 @@ main (int argc, char **argv)
     paxui_get_debug_level ();
 
     paxui = g_new0 (Paxui, 1);
+    paxui->bg_max = PAXUI_BG_REQUESTS;
+    leaf_registry_new (paxui);
     settings_setup_dirs (paxui);
 
     paxui->app = gtk_application_new ("org.paxui", G_APPLICATION_SEND_ENVIRONMENT);
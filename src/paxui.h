@@ -15,6 +15,9 @@
 
 #define PAXUI_UTF8_ELLIPSIS "\342\200\246"
 
+#define PAXUI_NUM_FACILITIES (PA_SUBSCRIPTION_EVENT_FACILITY_MASK + 1)
+#define PAXUI_GRID_COLS (6)
+
 
 typedef union _PaxuiColour PaxuiColour;
 
@@ -30,6 +33,31 @@ enum
     PAXUI_LEAF_NUM_TYPES
 };
 
+/* leaf fields changed since last gui update */
+enum
+{
+    PAXUI_DIRTY_NAME    = 1 << 0,
+    PAXUI_DIRTY_VOLUME  = 1 << 1,
+    PAXUI_DIRTY_MUTE    = 1 << 2
+};
+
+/* kinds of request to the server, for the operation tracker */
+enum
+{
+    PAXUI_OP_INFO_LIST = 0,
+    PAXUI_OP_INFO,
+    PAXUI_OP_SUBSCRIBE,
+    PAXUI_OP_VOLUME,
+    PAXUI_OP_MUTE,
+    PAXUI_OP_MOVE,
+    PAXUI_OP_LOAD_MODULE,
+    PAXUI_OP_UNLOAD_MODULE,
+    PAXUI_OP_NUM_KINDS
+};
+
+#define PAXUI_OP_BUCKETS (12)
+#define PAXUI_ECHO_RING (8)
+
 enum
 {
     PX_ICON_SOURCE = 0,
@@ -44,18 +72,46 @@ enum
 };
 
 
+/* interned pa name with display forms made on first use */
+typedef struct _PaxuiName
+{
+    gchar      *str;
+    gchar      *utf8;
+    gchar      *short_str;
+    guint       ref_count;
+} PaxuiName;
+
+/* request counts & latencies for one kind of operation */
+typedef struct _PaxuiOpStats
+{
+    guint       issued;
+    guint       done, failed, cancelled;
+    gint        last_errno;
+    gint64      total_usecs, max_usecs;
+    guint       hist[PAXUI_OP_BUCKETS];     /* bucket n: latency under 250us << n */
+} PaxuiOpStats;
+
+
 typedef struct _Paxui
 {
     pa_glib_mainloop   *pa_ml;
+    pa_threaded_mainloop *pa_tml;   /* set when pulse runs on its own thread */
     pa_mainloop_api    *pa_mlapi;
     pa_context         *pa_ctx;
+    gpointer            pa_deltas;  /* lock-free stack of replies from pa thread */
 
     gboolean            terminated;
     gboolean            updating;
-    gboolean            pa_init_done;
+    guint               update_src;     /* layout pass scheduled by trigger_update */
+    gboolean            layout_all;
+    gboolean            loading;        /* initial info lists in progress */
+    gboolean            populating;     /* building gui for initial lists */
+    guint               lists_pending;
 
     GtkApplication     *app;
     GtkWidget          *window;
+    GtkWidget          *header;
+    guint               error_src;  /* clears error from header */
     GtkWidget          *scr_win;
     GtkWidget          *layout;
     GtkWidget          *grid;
@@ -70,20 +126,65 @@ typedef struct _Paxui
     GList              *sink_inputs;
     GList              *modules;
     GList              *clients;
+    GList              *list_tail[PAXUI_LEAF_NUM_TYPES];   /* last link of each, NULL if unknown */
     GList              *acams;      /* active clients and modules */
     GList              *src_inits;
     GList              *cam_inits;
     GList              *snk_inits;
 
+    GHashTable         *names;                             /* interned pa names */
+    GHashTable         *owned;                             /* set of leaves with widgets or volume state */
+    GHashTable         *leaf_index[PAXUI_LEAF_NUM_TYPES];  /* pa index -> leaf */
+    GHashTable         *leaf_names[PAXUI_LEAF_NUM_TYPES];  /* interned name -> leaf */
+    GHashTable         *adjacency[PAXUI_LEAF_NUM_TYPES];   /* pa index -> set of so/si */
+    GHashTable         *touched[PAXUI_LEAF_NUM_TYPES];     /* pa indices changed since layout */
+
+    GHashTable         *ev_pending[PAXUI_NUM_FACILITIES];  /* pa indices awaiting info request */
+    GHashTable         *ev_inflight[PAXUI_NUM_FACILITIES]; /* pa index -> info request in flight */
+    guint               ev_flush_src;
+    guint               bg_inflight;    /* info requests in flight */
+    gboolean            bg_held;        /* pending requests held back by bg_max */
+    guint               ev_cursor;      /* facility the next flush starts at */
+    guint               ev_seq;         /* info requests sent so far */
+    GHashTable         *owner_waits;                       /* module index -> sink inputs awaiting its info */
+    GHashTable         *ignored_sis;                       /* set of filtered-out sink input indices */
+    GHashTable         *op_live;                           /* pa_operation -> tracker */
+    PaxuiOpStats        op_stats[PAXUI_OP_NUM_KINDS];
+    gint                op_errno;                          /* error an info cb saw, for its op */
+
     PaxuiColour        *colours;
     guint              *col_num;
     guint               num_colours;
     gint                end_row;
+    GArray             *grid_used[PAXUI_GRID_COLS];        /* bitset of occupied rows */
     gboolean            dark_theme;
     gboolean            volume_disabled;
+    gboolean            lazy_blocks;    /* fetch clients & modules only for streams */
+    gboolean            threaded_ml;    /* run pulse on a pa_threaded_mainloop */
+    guint               bg_max;         /* cap on bg_inflight, 0 for none */
     gboolean            tist_enabled;
 
     gint                drop_x, drop_y, drop_w, drop_h;
+
+    GQueue             *widget_pool[PAXUI_LEAF_NUM_TYPES]; /* spare outer widgets */
+
+    /* leaf arena: slabs of PAXUI_LEAF_SLAB leaves, handed out in order
+     * then recycled through leaf_free */
+    GPtrArray          *leaf_slabs;
+    guint               slab_cur, slab_used;
+    struct _PaxuiLeaf  *leaf_free;
+    guint               pool_hits, pool_misses;
+    guint               gui_updates, gui_skips, name_skips;
+
+    GArray             *edges;          /* cached so/si lines by colour */
+    GArray             *edge_row_start; /* offsets into edge_rows per band */
+    GArray             *edge_rows;      /* edge indices by band crossed */
+    gboolean            edges_valid;
+
+    cairo_surface_t    *edge_layer;     /* edges rendered for the viewport */
+    gdouble             edge_layer_x, edge_layer_y;
+    gint                edge_layer_w, edge_layer_h;
+    cairo_region_t     *edge_damage;    /* layer areas to re-render */
     GdkRGBA             drop_colour;
     gboolean            have_drop_colour;
 
@@ -116,15 +217,56 @@ union _PaxuiColour
 };
 
 
+/* gui state of a leaf, only while it has widgets */
+typedef struct _PaxuiView
+{
+    GtkWidget  *outer, *label;
+    gint        att_y;      /* row attached at, 0 if not in grid */
+
+    /* tool popover */
+    GtkWidget  *tool_button;
+    GtkWidget  *popover;
+    GtkWidget **sliders;
+    GtkWidget  *mute_button;
+    GtkWidget  *lock_button;
+    gboolean    locked;     /* lock state kept while popover is freed */
+    guint       popover_src;
+} PaxuiView;
+
+
+/* channel levels & set-volume state of a leaf with volume control */
+typedef struct _PaxuiVolume
+{
+    guint32     levels[PA_CHANNELS_MAX];
+    guint32     n_chan;
+    guint32     positions[PA_CHANNELS_MAX];    /* channel map */
+    guint32     n_pos;
+
+    pa_operation *op;       /* set-volume in flight */
+    gboolean    queued;     /* levels moved while it was out */
+    guint       seq;        /* volume sends so far */
+    guint32     sent_hash;  /* levels last sent, or last reported by server */
+    guint32     echoes[PAXUI_ECHO_RING];   /* sends not seen back, oldest first */
+    guint       n_echoes;
+
+    pa_operation *mute_op;  /* set-mute in flight */
+    guint       mute_seq;
+    guint32     mute_echoes[PAXUI_ECHO_RING];
+    guint       n_mute_echoes;
+} PaxuiVolume;
+
+
 typedef struct _PaxuiLeaf
 {
     guint       leaf_type;
 
     /* basic data */
     guint32     index;
-    gchar      *name;
-    gchar      *short_name;
-    gchar      *utf8_name;
+    const gchar *name;          /* strings owned by pname & pshort */
+    const gchar *short_name;
+    const gchar *utf8_name;
+    PaxuiName  *pname;
+    PaxuiName  *pshort;         /* short label if not from name */
 
     /* relative items by pa index */
     guint32     module;
@@ -133,33 +275,39 @@ typedef struct _PaxuiLeaf
     guint32     sink;
     guint32     monitor;
 
+    /* PAXUI_DIRTY_* bits pending for gui */
+    guint       dirty;
+
     /* whether client/module owns so/si */
     gboolean    active;
 
+    /* whether so/si is in the adjacency sets of its client, module & device */
+    gboolean    linked;
+
+    /* so/si moves sent & not yet answered */
+    guint       moves_pending;
+
     /* back reference to main struct */
     Paxui      *paxui;
 
-    /* gui data */
-    GtkWidget  *outer, *label;
+    /* next recycled slot while on the arena free list */
+    struct _PaxuiLeaf *next_free;
+
+    /* own nodes in type list & acams, for removal without list walk */
+    GList      *link;
+    GList      *acam_link;
+
+    /* layout, kept while widgets come & go */
     gint        x, y;       /* grid coords */
     gint        colour;
 
-    /* volume control */
+    /* widgets, NULL for leaves not shown */
+    PaxuiView  *view;
+
+    /* volume control, vol set only while enabled */
     gboolean    vol_enabled;
     gboolean    muted;
-    guint32    *levels;
-    guint32     n_chan;
-
-    /* channel map */
-    guint32    *positions;
-    guint32     n_pos;
-
-    /* tool popover */
-    GtkWidget  *tool_button;
-    GtkWidget  *popover;
-    GtkWidget **sliders;
-    GtkWidget  *mute_button;
-    GtkWidget  *lock_button;
+    PaxuiVolume *vol;
 } PaxuiLeaf;
 
 
@@ -170,6 +318,14 @@ typedef struct _PaxuiState
 } PaxuiState;
 
 
+typedef struct _PaxuiEdge
+{
+    gint        colour;
+    gdouble     x1, y1;
+    gdouble     x2, y2;
+} PaxuiEdge;
+
+
 typedef struct _PaxuiInitItem
 {
     gchar      *str1;
@@ -181,6 +337,14 @@ typedef struct _PaxuiInitItem
 extern gint debug;
 
 
+PaxuiName          *paxui_name_lookup                   (const Paxui *paxui, const gchar *str);
+PaxuiName          *paxui_name_intern                   (Paxui *paxui, const gchar *str);
+void                paxui_name_release                  (Paxui *paxui, PaxuiName *pn);
+const gchar        *paxui_name_utf8                     (PaxuiName *pn);
+const gchar        *paxui_name_short                    (PaxuiName *pn);
+
+PaxuiLeaf          *paxui_find_leaf_for_index           (const Paxui *paxui, guint leaf_type, guint32 index);
+PaxuiLeaf          *paxui_find_leaf_for_name            (const Paxui *paxui, guint leaf_type, const gchar *name);
 PaxuiLeaf          *paxui_find_module_for_index         (const Paxui *paxui, guint32 index);
 PaxuiLeaf          *paxui_find_client_for_index         (const Paxui *paxui, guint32 index);
 PaxuiLeaf          *paxui_find_source_for_index         (const Paxui *paxui, guint32 index);
@@ -188,8 +352,16 @@ PaxuiLeaf          *paxui_find_sink_for_index           (const Paxui *paxui, gui
 PaxuiLeaf          *paxui_find_source_output_for_index  (const Paxui *paxui, guint32 index);
 PaxuiLeaf          *paxui_find_sink_input_for_index     (const Paxui *paxui, guint32 index);
 void                paxui_block_update_active           (PaxuiLeaf *block, Paxui *paxui);
-
-PaxuiLeaf          *paxui_leaf_new                      (guint leaf_type);
+void                paxui_stream_link                   (PaxuiLeaf *stream);
+void                paxui_stream_unlink                 (PaxuiLeaf *stream);
+GHashTable         *paxui_streams_for_leaf              (const PaxuiLeaf *leaf);
+
+PaxuiLeaf          *paxui_leaf_new                      (Paxui *paxui, guint leaf_type);
+void                paxui_leaf_register                 (PaxuiLeaf *leaf);
+void                paxui_leaf_update_owned             (PaxuiLeaf *leaf);
+void                paxui_leaf_unregister               (PaxuiLeaf *leaf);
+void                paxui_leaf_set_name                 (PaxuiLeaf *leaf, const gchar *name);
+void                paxui_leaf_set_short_name           (PaxuiLeaf *leaf, const gchar *short_name);
 void                paxui_unload_data                   (Paxui *paxui);
 void                paxui_make_init_strings             (Paxui *paxui);
 void                paxui_unload_init_strings           (Paxui *paxui);